@@ -4,13 +4,22 @@
 #include "snitch/snitch_config.hpp"
 
 #include <array> // for small_vector
+#include <bit> // for std::bit_cast
 #include <cstddef> // for std::size_t
+#include <cstring> // for std::memcpy, std::memmove
 #if SNITCH_WITH_EXCEPTIONS
 #    include <exception> // for std::exception
 #endif
 #include <compare> // for std::partial_ordering
+#include <concepts> // for std::totally_ordered
+#include <cstdint> // for std::uint64_t
+#include <cstdio> // for std::FILE
 #include <initializer_list> // for std::initializer_list
+#include <iterator> // for std::forward_iterator_tag
+#include <limits> // for std::numeric_limits
+#include <new> // for small_function
 #include <optional> // for cli
+#include <span> // for replacement tables
 #include <string_view> // for all strings
 #include <type_traits> // for std::is_nothrow_*
 #include <variant> // for events and small_function
@@ -19,11 +28,13 @@
 // --------------------------------
 
 namespace snitch {
-// Maximum number of test cases in the whole program.
+// Maximum number of test cases added at run time with registry::add(); test cases declared with
+// the test case macros use their own storage, and are not limited.
 // A "test case" is created for each uses of the `*_TEST_CASE` macros,
 // and for each type for the `TEMPLATE_LIST_TEST_CASE` macro.
 constexpr std::size_t max_test_cases = SNITCH_MAX_TEST_CASES;
-// Maximum depth of nested sections in a test case (section in section in section ...).
+// Maximum depth of nested sections (section in section in section ...) stored in a copy of an
+// event; deeper sections are not copied. Running test cases are not limited.
 constexpr std::size_t max_nested_sections = SNITCH_MAX_NESTED_SECTIONS;
 // Maximum length of a `CHECK(...)` or `REQUIRE(...)` expression,
 // beyond which automatic variable printing is disabled.
@@ -33,14 +44,31 @@ constexpr std::size_t max_message_length = SNITCH_MAX_MESSAGE_LENGTH;
 // Maximum length of a full test case name.
 // The full test case name includes the base name, plus any type.
 constexpr std::size_t max_test_name_length = SNITCH_MAX_TEST_NAME_LENGTH;
-// Maximum number of captured expressions in a test case.
+// Maximum number of captured expressions stored in a copy of an event; further captures are not
+// copied. Running test cases are not limited.
 constexpr std::size_t max_captures = SNITCH_MAX_CAPTURES;
-// Maximum length of a captured expression.
+// Maximum length of a captured expression or info message; longer captures are truncated.
 constexpr std::size_t max_capture_length = SNITCH_MAX_CAPTURE_LENGTH;
 // Maximum number of unique tags in the whole program.
 constexpr std::size_t max_unique_tags = SNITCH_MAX_UNIQUE_TAGS;
 // Maximum number of command line arguments.
 constexpr std::size_t max_command_line_args = SNITCH_MAX_COMMAND_LINE_ARGS;
+// Maximum number of characters buffered before being written to the standard output.
+constexpr std::size_t max_buffered_output = SNITCH_MAX_BUFFERED_OUTPUT;
+// Maximum total length of the strings stored in an event copy.
+constexpr std::size_t max_event_copy_length = SNITCH_MAX_EVENT_COPY_LENGTH;
+// Maximum number of distinct failing check locations tracked in a test case.
+// Failures at locations beyond this limit are always reported.
+constexpr std::size_t max_failure_sites = SNITCH_MAX_FAILURE_SITES;
+// Maximum number of reporters that can be registered, and selected at the same time.
+constexpr std::size_t max_reporters = SNITCH_MAX_REPORTERS;
+// Maximum number of characters of output kept from a failed test case, when capturing output.
+constexpr std::size_t max_captured_output = SNITCH_MAX_CAPTURED_OUTPUT;
+// Maximum number of assertion sites in the whole program, for assertion coverage.
+constexpr std::size_t max_assertion_sites = SNITCH_MAX_ASSERTION_SITES;
+// Size in bytes of the buffer storing the captures, info messages, and sections of the test cases
+// running on a thread.
+constexpr std::size_t max_test_arena_size = SNITCH_MAX_TEST_ARENA_SIZE;
 } // namespace snitch
 
 // Forward declarations and public utilities.
@@ -112,12 +140,64 @@ struct type_list {};
 // -------------------------------
 
 namespace snitch {
+namespace impl {
+// Contiguous sequence of elements accepted by the bulk operations of small_vector.
+// Character vectors take a std::string_view, so that string literals do not include their
+// null terminator.
+template<typename ElemType>
+using const_range = std::conditional_t<
+    std::is_same_v<ElemType, char>,
+    std::string_view,
+    std::span<const ElemType>>;
+} // namespace impl
+
 template<typename ElemType>
 class small_vector_span {
     ElemType*    buffer_ptr  = nullptr;
     std::size_t  buffer_size = 0;
     std::size_t* data_size   = nullptr;
 
+    // Copies elements between non-overlapping ranges, in one memcpy for trivially copyable types.
+    static constexpr void
+    copy_elements(ElemType* dst, const ElemType* src, std::size_t count) noexcept(
+        std::is_nothrow_copy_assignable_v<ElemType>) {
+        if constexpr (std::is_trivially_copyable_v<ElemType>) {
+            if (!std::is_constant_evaluated()) {
+                if (count != 0u) {
+                    std::memcpy(dst, src, count * sizeof(ElemType));
+                }
+                return;
+            }
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            dst[i] = src[i];
+        }
+    }
+
+    // Moves elements within the buffer, in one memmove for trivially copyable types.
+    constexpr void shift_elements(std::size_t from, std::size_t to, std::size_t count) noexcept(
+        std::is_nothrow_move_assignable_v<ElemType>) {
+        if constexpr (std::is_trivially_copyable_v<ElemType>) {
+            if (!std::is_constant_evaluated()) {
+                if (count != 0u) {
+                    std::memmove(buffer_ptr + to, buffer_ptr + from, count * sizeof(ElemType));
+                }
+                return;
+            }
+        }
+
+        if (to < from) {
+            for (std::size_t i = 0; i < count; ++i) {
+                buffer_ptr[to + i] = std::move(buffer_ptr[from + i]);
+            }
+        } else {
+            for (std::size_t i = count; i-- > 0;) {
+                buffer_ptr[to + i] = std::move(buffer_ptr[from + i]);
+            }
+        }
+    }
+
 public:
     constexpr explicit small_vector_span(ElemType* b, std::size_t bl, std::size_t* s) noexcept :
         buffer_ptr(b), buffer_size(bl), data_size(s) {}
@@ -183,6 +263,45 @@ public:
 
         --*data_size;
     }
+    // Replaces the content of the vector with a copy of the elements.
+    // The elements must not be stored in this vector.
+    constexpr void assign(impl::const_range<ElemType> elems) noexcept(
+        std::is_nothrow_copy_assignable_v<ElemType>) {
+        resize(elems.size());
+        copy_elements(buffer_ptr, elems.data(), elems.size());
+    }
+    // Appends a copy of the elements at the end of the vector.
+    constexpr void append_range(impl::const_range<ElemType> elems) noexcept(
+        std::is_nothrow_copy_assignable_v<ElemType>) {
+        const std::size_t offset = *data_size;
+        grow(elems.size());
+        copy_elements(buffer_ptr + offset, elems.data(), elems.size());
+    }
+    // Inserts a copy of the elements before the element at index `pos`, and returns a pointer to
+    // the first inserted element. The elements must not be stored in this vector.
+    constexpr ElemType* insert(std::size_t pos, impl::const_range<ElemType> elems) noexcept(
+        std::is_nothrow_copy_assignable_v<ElemType> &&
+        std::is_nothrow_move_assignable_v<ElemType>) {
+        const std::size_t old_size = *data_size;
+        if (pos > old_size) {
+            terminate_with("insert() called with incorrect index");
+        }
+
+        grow(elems.size());
+        shift_elements(pos, pos + elems.size(), old_size - pos);
+        copy_elements(buffer_ptr + pos, elems.data(), elems.size());
+        return buffer_ptr + pos;
+    }
+    // Removes `count` elements starting at index `pos`.
+    constexpr void erase(std::size_t pos, std::size_t count = 1u) noexcept(
+        std::is_nothrow_move_assignable_v<ElemType>) {
+        if (pos > *data_size || count > *data_size - pos) {
+            terminate_with("erase() called with incorrect range");
+        }
+
+        shift_elements(pos + count, pos, *data_size - pos - count);
+        *data_size -= count;
+    }
     constexpr ElemType& back() noexcept {
         if (*data_size == 0) {
             terminate_with("back() called on empty vector");
@@ -290,6 +409,14 @@ public:
     }
 };
 
+} // namespace snitch
+
+// Spans do not own their elements, so iterators remain valid after the span is destroyed.
+template<typename ElemType>
+inline constexpr bool std::ranges::enable_borrowed_range<snitch::small_vector_span<ElemType>> =
+    true;
+
+namespace snitch {
 template<typename ElemType, std::size_t MaxLength>
 class small_vector {
     std::array<ElemType, MaxLength> data_buffer = {};
@@ -335,6 +462,22 @@ public:
     constexpr void pop_back() noexcept {
         return span().pop_back();
     }
+    constexpr void assign(impl::const_range<ElemType> elems) noexcept(
+        noexcept(this->span().assign(elems))) {
+        span().assign(elems);
+    }
+    constexpr void append_range(impl::const_range<ElemType> elems) noexcept(
+        noexcept(this->span().append_range(elems))) {
+        span().append_range(elems);
+    }
+    constexpr ElemType* insert(std::size_t pos, impl::const_range<ElemType> elems) noexcept(
+        noexcept(this->span().insert(pos, elems))) {
+        return span().insert(pos, elems);
+    }
+    constexpr void erase(std::size_t pos, std::size_t count = 1u) noexcept(
+        noexcept(this->span().erase(pos, count))) {
+        span().erase(pos, count);
+    }
     constexpr ElemType& back() noexcept {
         return span().back();
     }
@@ -403,10 +546,7 @@ public:
     constexpr small_string(const small_string& other) noexcept = default;
     constexpr small_string(small_string&& other) noexcept      = default;
     constexpr small_string(std::string_view str) noexcept {
-        resize(str.size());
-        for (std::size_t i = 0; i < str.size(); ++i) {
-            data_buffer[i] = str[i];
-        }
+        span().assign(str);
     }
     constexpr small_string&    operator=(const small_string& other) noexcept = default;
     constexpr small_string&    operator=(small_string&& other) noexcept      = default;
@@ -443,6 +583,18 @@ public:
     constexpr void pop_back() noexcept {
         return span().pop_back();
     }
+    constexpr void assign(std::string_view str) noexcept {
+        span().assign(str);
+    }
+    constexpr void append_range(std::string_view str) noexcept {
+        span().append_range(str);
+    }
+    constexpr char* insert(std::size_t pos, std::string_view str) noexcept {
+        return span().insert(pos, str);
+    }
+    constexpr void erase(std::size_t pos, std::size_t count = 1u) noexcept {
+        span().erase(pos, count);
+    }
     constexpr char& back() noexcept {
         return span().back();
     }
@@ -496,15 +648,145 @@ public:
     }
 };
 
-[[nodiscard]] bool append(small_string_span ss, std::string_view value) noexcept;
+[[nodiscard]] constexpr bool append(small_string_span ss, std::string_view str) noexcept {
+    if (str.empty()) {
+        return true;
+    }
+
+    const bool        could_fit  = str.size() <= ss.available();
+    const std::size_t copy_count = could_fit ? str.size() : ss.available();
+
+    const std::size_t offset = ss.size();
+    ss.grow(copy_count);
+    std::char_traits<char>::move(ss.begin() + offset, str.data(), copy_count);
+
+    return could_fit;
+}
+
+// Number formatting options, see hex() and padded().
+template<typename T>
+struct formatted_number {
+    T           value;
+    bool        hexadecimal = false;
+    std::size_t width       = 0;
+    char        fill        = ' ';
+};
+
+template<typename T>
+    requires std::is_arithmetic_v<T>
+constexpr formatted_number<T> hex(T value, std::size_t width = 0) noexcept {
+    return {value, true, width, '0'};
+}
+
+template<typename T>
+    requires std::is_arithmetic_v<T>
+constexpr formatted_number<T> padded(T value, std::size_t width, char fill = ' ') noexcept {
+    return {value, false, width, fill};
+}
+
+namespace impl {
+constexpr bool append_padded(
+    small_string_span ss, std::string_view number, std::size_t width, char fill) noexcept {
+    if (fill == '0' && !number.empty() && number[0] == '-') {
+        // Zero padding goes between the sign and the digits.
+        if (!append(ss, std::string_view("-"))) {
+            return false;
+        }
+
+        number.remove_prefix(1);
+        width = width > 0 ? width - 1 : 0;
+    }
+
+    for (std::size_t i = number.size(); i < width; ++i) {
+        if (ss.available() == 0) {
+            return false;
+        }
+
+        ss.push_back(fill);
+    }
+
+    return append(ss, number);
+}
+
+template<typename T>
+constexpr bool append_integer(
+    small_string_span ss, T value, bool hexadecimal, std::size_t width, char fill) noexcept {
+    constexpr std::string_view digits = "0123456789abcdef";
+
+    // Enough room for the sign and the decimal digits (at most three per byte).
+    std::array<char, sizeof(T) * 3 + 1> buffer = {};
+
+    bool negative = false;
+    if constexpr (std::is_signed_v<T>) {
+        negative = value < 0;
+    }
+
+    const std::size_t base      = hexadecimal ? 16u : 10u;
+    std::size_t       magnitude = negative ? std::size_t{0} - static_cast<std::size_t>(value)
+                                           : static_cast<std::size_t>(value);
+
+    std::size_t first = buffer.size();
+    do {
+        buffer[--first] = digits[magnitude % base];
+        magnitude /= base;
+    } while (magnitude != 0);
+
+    if (negative) {
+        buffer[--first] = '-';
+    }
+
+    return append_padded(
+        ss, std::string_view(buffer.data() + first, buffer.size() - first), width, fill);
+}
+
+[[nodiscard]] bool append_float(
+    small_string_span ss, float value, bool hexadecimal, std::size_t width, char fill) noexcept;
+[[nodiscard]] bool append_float(
+    small_string_span ss, double value, bool hexadecimal, std::size_t width, char fill) noexcept;
+} // namespace impl
 
 [[nodiscard]] bool append(small_string_span ss, const void* ptr) noexcept;
 [[nodiscard]] bool append(small_string_span ss, std::nullptr_t) noexcept;
-[[nodiscard]] bool append(small_string_span ss, std::size_t i) noexcept;
-[[nodiscard]] bool append(small_string_span ss, std::ptrdiff_t i) noexcept;
-[[nodiscard]] bool append(small_string_span ss, float f) noexcept;
-[[nodiscard]] bool append(small_string_span ss, double f) noexcept;
-[[nodiscard]] bool append(small_string_span ss, bool value) noexcept;
+[[nodiscard]] constexpr bool append(small_string_span ss, std::size_t i) noexcept {
+    return impl::append_integer(ss, i, false, 0, ' ');
+}
+[[nodiscard]] constexpr bool append(small_string_span ss, std::ptrdiff_t i) noexcept {
+    return impl::append_integer(ss, i, false, 0, ' ');
+}
+[[nodiscard]] constexpr bool append(small_string_span ss, float f) noexcept {
+    // Floating point formatting is not available in constant expressions.
+    return std::is_constant_evaluated() ? append(ss, std::string_view("?"))
+                                        : impl::append_float(ss, f, false, 0, ' ');
+}
+[[nodiscard]] constexpr bool append(small_string_span ss, double d) noexcept {
+    return std::is_constant_evaluated() ? append(ss, std::string_view("?"))
+                                        : impl::append_float(ss, d, false, 0, ' ');
+}
+[[nodiscard]] constexpr bool append(small_string_span ss, bool value) noexcept {
+    return append(ss, std::string_view(value ? "true" : "false"));
+}
+
+template<typename T>
+[[nodiscard]] constexpr bool append(small_string_span ss, const formatted_number<T>& f) noexcept {
+    if constexpr (std::is_floating_point_v<T>) {
+        using float_type = std::conditional_t<std::is_same_v<T, float>, float, double>;
+        if (std::is_constant_evaluated()) {
+            return impl::append_padded(ss, std::string_view("?"), f.width, f.fill);
+        }
+
+        return impl::append_float(
+            ss, static_cast<float_type>(f.value), f.hexadecimal, f.width, f.fill);
+    } else if constexpr (std::is_same_v<T, bool>) {
+        return impl::append_padded(
+            ss, std::string_view(f.value ? "true" : "false"), f.width, f.fill);
+    } else if constexpr (std::is_signed_v<T>) {
+        return impl::append_integer(
+            ss, static_cast<std::ptrdiff_t>(f.value), f.hexadecimal, f.width, f.fill);
+    } else {
+        return impl::append_integer(
+            ss, static_cast<std::size_t>(f.value), f.hexadecimal, f.width, f.fill);
+    }
+}
 template<typename T>
 [[nodiscard]] bool append(small_string_span ss, T* ptr) noexcept {
     if constexpr (std::is_same_v<std::remove_cv_t<T>, char>) {
@@ -520,7 +802,7 @@ template<typename T>
     }
 }
 template<std::size_t N>
-[[nodiscard]] bool append(small_string_span ss, const char str[N]) noexcept {
+[[nodiscard]] constexpr bool append(small_string_span ss, const char str[N]) noexcept {
     return append(ss, std::string_view(str));
 }
 
@@ -537,22 +819,22 @@ template<typename T>
 concept enumeration = std::is_enum_v<T>;
 
 template<signed_integral T>
-[[nodiscard]] bool append(small_string_span ss, T value) noexcept {
+[[nodiscard]] constexpr bool append(small_string_span ss, T value) noexcept {
     return snitch::append(ss, static_cast<std::ptrdiff_t>(value));
 }
 
 template<unsigned_integral T>
-[[nodiscard]] bool append(small_string_span ss, T value) noexcept {
+[[nodiscard]] constexpr bool append(small_string_span ss, T value) noexcept {
     return snitch::append(ss, static_cast<std::size_t>(value));
 }
 
 template<enumeration T>
-[[nodiscard]] bool append(small_string_span ss, T value) noexcept {
+[[nodiscard]] constexpr bool append(small_string_span ss, T value) noexcept {
     return append(ss, static_cast<std::underlying_type_t<T>>(value));
 }
 
 template<convertible_to<std::string_view> T>
-[[nodiscard]] bool append(small_string_span ss, const T& value) noexcept {
+[[nodiscard]] constexpr bool append(small_string_span ss, const T& value) noexcept {
     return snitch::append(ss, std::string_view(value));
 }
 
@@ -560,7 +842,7 @@ template<typename T>
 concept string_appendable = requires(small_string_span ss, T value) { append(ss, value); };
 
 template<string_appendable T, string_appendable U, string_appendable... Args>
-[[nodiscard]] bool append(small_string_span ss, T&& t, U&& u, Args&&... args) noexcept {
+[[nodiscard]] constexpr bool append(small_string_span ss, T&& t, U&& u, Args&&... args) noexcept {
     return append(ss, std::forward<T>(t)) && append(ss, std::forward<U>(u)) &&
            (append(ss, std::forward<Args>(args)) && ...);
 }
@@ -577,9 +859,36 @@ bool append_or_truncate(small_string_span ss, Args&&... args) noexcept {
     return true;
 }
 
+// Replaces all occurrences of the pattern in the string. If the result does not fit, it is
+// truncated to the capacity of the string, possibly in the middle of a replacement, and false is
+// returned.
 [[nodiscard]] bool replace_all(
     small_string_span string, std::string_view pattern, std::string_view replacement) noexcept;
 
+struct string_replacement {
+    std::string_view pattern;
+    std::string_view replacement;
+};
+
+// Appends the string, replacing all occurrences of the patterns in a single scan. At each
+// position, the patterns are tried in order and the first match wins. If the result does not
+// fit, it is truncated and false is returned. The string must not overlap with the destination.
+[[nodiscard]] bool append_replaced(
+    small_string_span                   ss,
+    std::string_view                    string,
+    std::span<const string_replacement> replacements) noexcept;
+
+namespace impl {
+// All the control characters (below 0x20), to use as one-character patterns in replacement tables.
+inline constexpr std::array<char, 32> control_characters = []() {
+    std::array<char, 32> characters = {};
+    for (std::size_t i = 0; i < characters.size(); ++i) {
+        characters[i] = static_cast<char>(i);
+    }
+    return characters;
+}();
+} // namespace impl
+
 template<typename T, typename U>
 concept matcher_for = requires(const T& m, const U& value) {
                           { m.match(value) } -> convertible_to<bool>;
@@ -613,65 +922,100 @@ class small_function {
 
 template<typename Ret, typename... Args>
 class small_function<Ret(Args...) noexcept> {
-    using function_ptr            = Ret (*)(Args...) noexcept;
-    using function_data_ptr       = Ret (*)(void*, Args...) noexcept;
-    using function_const_data_ptr = Ret (*)(const void*, Args...) noexcept;
+public:
+    // Maximum size of a callable object stored inline, when it is not given by reference.
+    static constexpr std::size_t max_inline_size = 4 * sizeof(void*);
 
-    struct function_and_data_ptr {
-        void*             data = nullptr;
-        function_data_ptr ptr;
-    };
+private:
+    using function_ptr = Ret (*)(Args...) noexcept;
 
-    struct function_and_const_data_ptr {
-        const void*             data = nullptr;
-        function_const_data_ptr ptr;
+    union storage_type {
+        function_ptr function = nullptr;
+        void*        object;
+        const void*  const_object;
+        alignas(std::max_align_t) unsigned char buffer[max_inline_size];
     };
 
-    using data_type = std::
-        variant<std::monostate, function_ptr, function_and_data_ptr, function_and_const_data_ptr>;
+    using invoke_ptr = Ret (*)(const storage_type&, Args...) noexcept;
 
-    data_type data;
+    storage_type storage;
+    invoke_ptr   invoke = &invoke_empty;
+
+    static Ret invoke_empty(const storage_type&, Args...) noexcept {
+        terminate_with("small_function called without an implementation");
+    }
+
+    template<typename T>
+    static constexpr bool is_storable_inline = sizeof(T) <= max_inline_size &&
+                                               alignof(T) <= alignof(std::max_align_t) &&
+                                               std::is_trivially_copyable_v<T> &&
+                                               std::is_trivially_destructible_v<T>;
 
 public:
     constexpr small_function() = default;
 
-    constexpr small_function(function_ptr ptr) noexcept : data{ptr} {}
+    constexpr small_function(function_ptr ptr) noexcept :
+        invoke([](const storage_type& s, Args... args) noexcept -> Ret {
+            return (*s.function)(std::move(args)...);
+        }) {
+        storage.function = ptr;
+    }
 
     template<convertible_to<function_ptr> T>
-    constexpr small_function(T&& obj) noexcept : data{static_cast<function_ptr>(obj)} {}
+    constexpr small_function(T&& obj) noexcept : small_function(static_cast<function_ptr>(obj)) {}
 
     template<typename T, auto M>
     constexpr small_function(T& obj, constant<M>) noexcept :
-        data{function_and_data_ptr{
-            &obj, [](void* ptr, Args... args) noexcept {
-                if constexpr (std::is_same_v<Ret, void>) {
-                    (static_cast<T*>(ptr)->*constant<M>::value)(std::move(args)...);
-                } else {
-                    return (static_cast<T*>(ptr)->*constant<M>::value)(std::move(args)...);
-                }
-            }}} {}
+        invoke([](const storage_type& s, Args... args) noexcept -> Ret {
+            return (static_cast<T*>(s.object)->*constant<M>::value)(std::move(args)...);
+        }) {
+        storage.object = &obj;
+    }
 
     template<typename T, auto M>
     constexpr small_function(const T& obj, constant<M>) noexcept :
-        data{function_and_const_data_ptr{
-            &obj, [](const void* ptr, Args... args) noexcept {
-                if constexpr (std::is_same_v<Ret, void>) {
-                    (static_cast<const T*>(ptr)->*constant<M>::value)(std::move(args)...);
-                } else {
-                    return (static_cast<const T*>(ptr)->*constant<M>::value)(std::move(args)...);
-                }
-            }}} {}
+        invoke([](const storage_type& s, Args... args) noexcept -> Ret {
+            return (static_cast<const T*>(s.const_object)->*constant<M>::value)(
+                std::move(args)...);
+        }) {
+        storage.const_object = &obj;
+    }
 
+    // Callable objects given by reference are not copied, and must outlive the small_function.
     template<typename T>
+        requires(!std::is_same_v<std::remove_cv_t<T>, small_function>)
     constexpr small_function(T& obj) noexcept : small_function(obj, constant<&T::operator()>{}) {}
 
     template<typename T>
+        requires(!std::is_same_v<T, small_function>)
     constexpr small_function(const T& obj) noexcept :
         small_function(obj, constant<&T::operator()>{}) {}
 
-    // Prevent inadvertently using temporary stateful lambda; not supported at the moment.
+    // Temporary callable objects are moved into the inline storage. They are called from a const
+    // small_function, so they must be callable as const.
+    template<typename T>
+        requires(
+            !std::is_reference_v<T> && !std::is_same_v<T, small_function> &&
+            !convertible_to<T, function_ptr> && std::is_invocable_v<const T&, Args...>)
+    small_function(T&& obj) noexcept :
+        invoke([](const storage_type& s, Args... args) noexcept -> Ret {
+            const T& callable = *std::launder(reinterpret_cast<const T*>(s.buffer));
+            return callable(std::move(args)...);
+        }) {
+        static_assert(
+            is_storable_inline<T>,
+            "temporary callable is too large, or not trivially copyable; store it elsewhere and "
+            "pass it by reference");
+        new (storage.buffer) T(std::move(obj));
+    }
+
+    // Temporary callable objects which are not callable as const (like mutable lambdas) are not
+    // supported; pass them by reference instead.
     template<typename T>
-    constexpr small_function(T&& obj) noexcept = delete;
+        requires(
+            !std::is_reference_v<T> && !std::is_same_v<T, small_function> &&
+            !convertible_to<T, function_ptr> && !std::is_invocable_v<const T&, Args...>)
+    small_function(T&& obj) noexcept = delete;
 
     // Prevent inadvertently using temporary object; not supported at the moment.
     template<typename T, auto M>
@@ -679,39 +1023,11 @@ public:
 
     template<typename... CArgs>
     constexpr Ret operator()(CArgs&&... args) const noexcept {
-        if constexpr (std::is_same_v<Ret, void>) {
-            std::visit(
-                overload{
-                    [](std::monostate) {
-                        terminate_with("small_function called without an implementation");
-                    },
-                    [&](function_ptr f) { (*f)(std::forward<CArgs>(args)...); },
-                    [&](const function_and_data_ptr& f) {
-                        (*f.ptr)(f.data, std::forward<CArgs>(args)...);
-                    },
-                    [&](const function_and_const_data_ptr& f) {
-                        (*f.ptr)(f.data, std::forward<CArgs>(args)...);
-                    }},
-                data);
-        } else {
-            return std::visit(
-                overload{
-                    [](std::monostate) -> Ret {
-                        terminate_with("small_function called without an implementation");
-                    },
-                    [&](function_ptr f) { return (*f)(std::forward<CArgs>(args)...); },
-                    [&](const function_and_data_ptr& f) {
-                        return (*f.ptr)(f.data, std::forward<CArgs>(args)...);
-                    },
-                    [&](const function_and_const_data_ptr& f) {
-                        return (*f.ptr)(f.data, std::forward<CArgs>(args)...);
-                    }},
-                data);
-        }
+        return (*invoke)(storage, std::forward<CArgs>(args)...);
     }
 
     constexpr bool empty() const noexcept {
-        return std::holds_alternative<std::monostate>(data);
+        return invoke == &invoke_empty;
     }
 };
 } // namespace snitch
@@ -735,6 +1051,60 @@ struct test_case {
     test_id         id    = {};
     test_ptr        func  = nullptr;
     test_case_state state = test_case_state::not_run;
+    test_case*      next  = nullptr;
+};
+
+// Storage for the test cases of a template test case, one per type.
+template<typename... Args>
+using typed_test_cases = test_case[sizeof...(Args)];
+
+template<typename T>
+struct type_list_test_cases_t;
+
+template<template<typename...> typename TL, typename... Args>
+struct type_list_test_cases_t<TL<Args...>> {
+    using type = typed_test_cases<Args...>;
+};
+
+template<typename T>
+using type_list_test_cases = typename type_list_test_cases_t<T>::type;
+
+// Iterates over the test cases of a registry, in the order they were added.
+template<typename T>
+class test_case_iterator {
+    T* node = nullptr;
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = std::remove_const_t<T>;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = T*;
+    using reference         = T&;
+
+    constexpr test_case_iterator() noexcept = default;
+    constexpr explicit test_case_iterator(T* n) noexcept : node(n) {}
+
+    constexpr T& operator*() const noexcept {
+        return *node;
+    }
+
+    constexpr T* operator->() const noexcept {
+        return node;
+    }
+
+    constexpr test_case_iterator& operator++() noexcept {
+        node = node->next;
+        return *this;
+    }
+
+    constexpr test_case_iterator operator++(int) noexcept {
+        test_case_iterator previous = *this;
+        node                        = node->next;
+        return previous;
+    }
+
+    friend constexpr bool
+    operator==(const test_case_iterator&, const test_case_iterator&) noexcept = default;
 };
 
 struct section_nesting_level {
@@ -744,22 +1114,92 @@ struct section_nesting_level {
 };
 
 struct section_state {
-    small_vector<section_id, max_nested_sections>            current_section = {};
-    small_vector<section_nesting_level, max_nested_sections> levels          = {};
-    std::size_t                                              depth           = 0;
-    bool                                                     leaf_executed   = false;
+    std::size_t depth         = 0;
+    bool        leaf_executed = false;
+};
+
+// Storage for the captures and sections of a running test case, in a region of a static buffer
+// (see `max_test_arena_size`). Captures and entered sections are records of variable length,
+// added at the front of the region, and removed in reverse order when their scope exits. The
+// nesting levels of sections outlive the section scopes, so they are added at the back of the
+// region. A test case started while another is running (when testing snitch itself) uses the
+// free space in between.
+class test_arena {
+    struct record_header {
+        record_header* previous = nullptr;
+        std::size_t    size     = 0;
+        bool           section  = false;
+    };
+
+    char*          region_begin  = nullptr;
+    char*          region_end    = nullptr;
+    record_header* last_record   = nullptr;
+    std::size_t    sections_size = 0;
+    std::size_t    captures_size = 0;
+    std::size_t    levels_size   = 0;
+
+    char*          get_front() const noexcept;
+    char*          get_back() const noexcept;
+    std::size_t    get_available(std::size_t new_sections, std::size_t new_captures) const noexcept;
+    record_header* add_record(std::size_t size, bool section) noexcept;
+
+public:
+    struct lists {
+        small_vector_span<const section_id>       sections;
+        small_vector_span<const std::string_view> captures;
+    };
+
+    constexpr test_arena() noexcept = default;
+    test_arena(char* begin, char* end) noexcept;
+
+    // Returns an arena using the free space of this one. Nothing must be added to this arena
+    // while the returned arena is in use.
+    test_arena make_nested() const noexcept;
+
+    // Adds a capture, written by appending to the returned string, which spans the free space of
+    // the arena up to `max_capture_length` characters. The record only keeps the characters
+    // written. Returns nothing if the arena is full.
+    std::optional<small_string_span> add_capture() noexcept;
+
+    // Adds an entered section. Returns false if the arena is full.
+    bool add_section(const section_id& section) noexcept;
+
+    // Removes the capture or section added last.
+    void remove_last() noexcept;
+
+    // Removes all the captures and sections.
+    void clear() noexcept;
+
+    // Lists the entered sections and the captures, in order, in the free space of the arena.
+    // The lists remain valid until the arena is modified.
+    lists list() noexcept;
+
+    std::size_t            level_count() const noexcept;
+    section_nesting_level& level(std::size_t index) noexcept;
+
+    // Adds a nesting level. Returns false if the arena is full.
+    bool add_level() noexcept;
+    void remove_level() noexcept;
+    void clear_levels() noexcept;
 };
 
-using capture_state = small_vector<small_string<max_capture_length>, max_captures>;
+struct failure_site {
+    std::string_view file  = {};
+    std::size_t      line  = 0u;
+    std::size_t      count = 0u;
+};
+
+using failure_site_state = small_vector<failure_site, max_failure_sites>;
 
 struct test_state {
-    registry&     reg;
-    test_case&    test;
-    section_state sections    = {};
-    capture_state captures    = {};
-    std::size_t   asserts     = 0;
-    bool          may_fail    = false;
-    bool          should_fail = false;
+    registry&          reg;
+    test_case&         test;
+    test_arena         arena       = {};
+    section_state      sections    = {};
+    failure_site_state failures    = {};
+    std::size_t        asserts     = 0;
+    bool               may_fail    = false;
+    bool               should_fail = false;
 #if SNITCH_WITH_TIMINGS
     float duration = 0.0f;
 #endif
@@ -769,10 +1209,51 @@ test_state& get_current_test() noexcept;
 test_state* try_get_current_test() noexcept;
 void        set_current_test(test_state* current) noexcept;
 
+// Output of the selected reporter currently handling an event on this thread, if any, where
+// registry::print() writes. Code forwarding events to another thread must pass it along.
+std::FILE* get_current_output() noexcept;
+void       set_current_output(std::FILE* output) noexcept;
+
+#if SNITCH_WITH_ASSERTION_EVENTS
+// Source file of an assertion site, usable as a template argument.
+template<std::size_t N>
+struct site_file {
+    char data[N] = {};
+
+    constexpr site_file(const char (&file)[N]) noexcept {
+        for (std::size_t i = 0; i < N; ++i) {
+            data[i] = file[i];
+        }
+    }
+};
+
+// Returns the index of the site in the assertion coverage bitmap. Sites registered after
+// max_assertion_sites was reached get an index past the end, and are not tracked.
+std::size_t register_assertion_site(std::string_view file, std::size_t line) noexcept;
+void        mark_assertion_site(std::size_t index) noexcept;
+
+// Each assertion site registers itself when the program starts, so sites which never execute
+// are known too.
+template<site_file File, std::size_t Line>
+struct assertion_site {
+    static inline const std::size_t index =
+        register_assertion_site(std::string_view{File.data, sizeof(File.data) - 1u}, Line);
+};
+#endif
+
+// Time from the clock used to measure durations, in nanoseconds since an arbitrary epoch.
+using time_point_t = std::uint64_t;
+
+time_point_t get_current_time() noexcept;
+float        get_duration_in_seconds(time_point_t start, time_point_t end) noexcept;
+
 struct section_entry_checker {
     section_id  section = {};
     test_state& state;
     bool        entered = false;
+#if SNITCH_WITH_TIMINGS
+    time_point_t start_time = 0;
+#endif
 
     ~section_entry_checker() noexcept;
 
@@ -806,16 +1287,140 @@ struct expression {
     small_string<max_expr_length> actual   = {};
 
     template<string_appendable T>
-    [[nodiscard]] bool append_value(T&& value) noexcept {
+    [[nodiscard]] constexpr bool append_value(T&& value) noexcept {
         return append(actual, std::forward<T>(value));
     }
 
     template<typename T>
-    [[nodiscard]] bool append_value(T&&) noexcept {
+    [[nodiscard]] constexpr bool append_value(T&&) noexcept {
         return append(actual, "?");
     }
 };
 
+template<typename R>
+using range_element_t = std::remove_cvref_t<decltype(*std::data(std::declval<const R&>()))>;
+
+// Operands of an equality comparison which, if too long to be displayed in full, are displayed
+// as a window around their differences.
+template<typename T>
+concept diffable_string = convertible_to<T, std::string_view>;
+
+template<typename T>
+concept diffable_range = !diffable_string<T> && requires(const T& value) {
+                                                    std::size(value);
+                                                    std::data(value);
+                                                } && string_appendable<range_element_t<T>>;
+
+template<typename T, typename U>
+concept diffable = (diffable_string<T> && diffable_string<U>) ||
+                   (diffable_range<T> && diffable_range<U>);
+
+// Number of equal elements displayed before and after the differences.
+constexpr std::size_t diff_string_context = 16u;
+constexpr std::size_t diff_range_context  = 4u;
+
+template<typename T>
+constexpr auto diff_view(const T& value) noexcept {
+    if constexpr (diffable_string<T>) {
+        return std::string_view(value);
+    } else {
+        return std::span<const range_element_t<T>>(std::data(value), std::size(value));
+    }
+}
+
+// Appends the elements [first, last), with "..." in place of the elements left out.
+template<typename V>
+[[nodiscard]] constexpr bool
+append_diff_side(small_string_span ss, const V& v, std::size_t first, std::size_t last) noexcept {
+    if constexpr (std::is_same_v<V, std::string_view>) {
+        return append(ss, std::string_view(first > 0u ? "..." : "")) &&
+               append(ss, v.substr(first, last - first)) &&
+               append(ss, std::string_view(last < v.size() ? "..." : ""));
+    } else {
+        bool fits = append(ss, std::string_view(first > 0u ? "{..., " : "{"));
+        for (std::size_t i = first; i < last && fits; ++i) {
+            fits = append(ss, std::string_view(i != first ? ", " : "")) && append(ss, v[i]);
+        }
+
+        return fits && append(ss, std::string_view(last < v.size() ? ", ...}" : "}"));
+    }
+}
+
+// Appends "lhs op rhs". If this does not fit, only the first differing hunk is displayed
+// with some context around it, followed by the index of the first difference. Only the
+// common prefix and suffix are skipped, so the cost is linear and no memory is allocated.
+template<typename T, typename U>
+[[nodiscard]] constexpr bool
+append_diff(expression& expr, const T& lhs, std::string_view op, const U& rhs) noexcept {
+    const auto a = diff_view(lhs);
+    const auto b = diff_view(rhs);
+
+    if (append_diff_side(expr.actual, a, 0u, a.size()) && append(expr.actual, op) &&
+        append_diff_side(expr.actual, b, 0u, b.size())) {
+        return true;
+    }
+
+    expr.actual.clear();
+
+    const std::size_t min_size = a.size() < b.size() ? a.size() : b.size();
+    std::size_t       prefix   = 0u;
+    while (prefix < min_size && a[prefix] == b[prefix]) {
+        ++prefix;
+    }
+
+    if (prefix == a.size() && prefix == b.size()) {
+        // No difference to show.
+        return false;
+    }
+
+    std::size_t suffix = 0u;
+    while (suffix < min_size - prefix && a[a.size() - 1u - suffix] == b[b.size() - 1u - suffix]) {
+        ++suffix;
+    }
+
+    constexpr std::size_t context =
+        std::is_same_v<decltype(a), const std::string_view> ? diff_string_context
+                                                            : diff_range_context;
+
+    const std::size_t first        = prefix - (prefix < context ? prefix : context);
+    const std::size_t suffix_shown = suffix < context ? suffix : context;
+    const std::size_t last_a       = a.size() - suffix + suffix_shown;
+    const std::size_t last_b       = b.size() - suffix + suffix_shown;
+
+    small_string<max_expr_length> note;
+    if (!append(
+            note, std::string_view(" (first difference at index "), prefix,
+            std::string_view(")"))) {
+        return false;
+    }
+
+    constexpr std::size_t min_side = 8u;
+
+    const std::size_t reserved = op.size() + note.size();
+    if (expr.actual.capacity() < reserved + 2u * min_side) {
+        return false;
+    }
+
+    // Each side gets half of the remaining space, and is truncated with "..." if needed.
+    const std::size_t side_capacity = (expr.actual.capacity() - reserved) / 2u;
+    auto append_side = [&](const auto& v, std::size_t last) {
+        small_string<max_expr_length> buffer;
+        std::size_t                   size = 0u;
+        small_string_span             side(buffer.data(), side_capacity, &size);
+        if (!append_diff_side(side, v, first, last)) {
+            side.resize(side_capacity);
+            side[side_capacity - 1u] = '.';
+            side[side_capacity - 2u] = '.';
+            side[side_capacity - 3u] = '.';
+        }
+
+        return append(expr.actual, std::string_view(side.data(), side.size()));
+    };
+
+    return append_side(a, last_a) && append(expr.actual, op) && append_side(b, last_b) &&
+           append(expr.actual, note);
+}
+
 template<bool CheckMode>
 struct invalid_expression {
     // This is an invalid expression; any further operator should produce another invalid
@@ -903,7 +1508,7 @@ struct extracted_binary_expression {
 
 #undef EXPR_OPERATOR_INVALID
 
-    explicit operator bool() const noexcept
+    constexpr explicit operator bool() const noexcept
         requires(!CheckMode || requires(const T& lhs, const U& rhs) { O{}(lhs, rhs); })
     {
         if (O{}(lhs, rhs) != Expected) {
@@ -923,6 +1528,12 @@ struct extracted_binary_expression {
                 if (!expr.append_value(rhs.describe_match(lhs, status))) {
                     expr.actual.clear();
                 }
+            } else if constexpr (
+                diffable<T, U> &&
+                (std::is_same_v<O, operator_equal> || std::is_same_v<O, operator_not_equal>)) {
+                if (!append_diff(expr, lhs, Expected ? O::inverse : O::actual, rhs)) {
+                    expr.actual.clear();
+                }
             } else {
                 if (!expr.append_value(lhs) ||
                     !(Expected ? expr.append_value(O::inverse) : expr.append_value(O::actual)) ||
@@ -987,7 +1598,7 @@ struct extracted_unary_expression {
 
 #undef EXPR_OPERATOR_INVALID
 
-    explicit operator bool() const noexcept
+    constexpr explicit operator bool() const noexcept
         requires(!CheckMode || requires(const T& lhs) { static_cast<bool>(lhs); })
     {
         if (static_cast<bool>(lhs) != Expected) {
@@ -1016,40 +1627,72 @@ struct expression_extractor {
 template<typename T>
 constexpr bool is_decomposable = requires(const T& t) { static_cast<bool>(t); };
 
+// Result of a check evaluated in a constant expression, reported at run time.
+struct constant_check_result {
+    bool       failed = false;
+    expression expr   = {};
+};
+
+constexpr bool is_constant_evaluated() noexcept {
+    return std::is_constant_evaluated();
+}
+
+// Not constexpr on purpose: reaching this function during constant evaluation is what makes
+// the compilation fail.
+inline void constant_check_failed(std::string_view) noexcept {}
+
+constexpr void constant_check(bool success, std::string_view check) noexcept {
+    if (!success) {
+        constant_check_failed(check);
+    }
+}
+
+template<auto Function>
+void run_constexpr_test_case() noexcept {
+    // Instantiated at the end of the translation unit, once the test function is defined.
+    [[maybe_unused]] constexpr bool done = (Function(), true);
+}
+
 struct scoped_capture {
-    capture_state& captures;
-    std::size_t    count = 0;
+    test_arena& arena;
+    std::size_t count = 0;
 
     ~scoped_capture() noexcept {
-        captures.resize(captures.size() - count);
+        for (std::size_t i = 0; i < count; ++i) {
+            arena.remove_last();
+        }
     }
 };
 
 std::string_view extract_next_name(std::string_view& names) noexcept;
 
-small_string<max_capture_length>& add_capture(test_state& state) noexcept;
+small_string_span add_capture(test_state& state) noexcept;
 
 template<string_appendable T>
 void add_capture(test_state& state, std::string_view& names, const T& arg) noexcept {
-    auto& capture = add_capture(state);
-    append_or_truncate(capture, extract_next_name(names), " := ", arg);
+    append_or_truncate(add_capture(state), extract_next_name(names), " := ", arg);
 }
 
 template<string_appendable... Args>
 scoped_capture
 add_captures(test_state& state, std::string_view names, const Args&... args) noexcept {
     (add_capture(state, names, args), ...);
-    return {state.captures, sizeof...(args)};
+    return {state.arena, sizeof...(args)};
 }
 
 template<string_appendable... Args>
 scoped_capture add_info(test_state& state, const Args&... args) noexcept {
-    auto& capture = add_capture(state);
-    append_or_truncate(capture, args...);
-    return {state.captures, 1};
+    append_or_truncate(add_capture(state), args...);
+    return {state.arena, 1};
 }
 
 void stdout_print(std::string_view message) noexcept;
+void stdout_flush() noexcept;
+
+// Stream on the standard output, for reporters which need a file. Unlike stdout, it is not
+// redirected while the output of a test case is captured; it is flushed along with the output
+// of stdout_print(). Created on the first call, which must not race with another.
+std::FILE* stdout_file() noexcept;
 
 struct abort_exception {};
 
@@ -1081,6 +1724,8 @@ enum class test_case_state { success, failed, skipped };
 namespace event {
 struct test_run_started {
     std::string_view name = {};
+    // Number of test cases selected to run.
+    std::size_t test_count = 0;
 };
 
 struct test_run_ended {
@@ -1105,6 +1750,24 @@ struct test_case_ended {
     std::size_t     assertion_count = 0;
 #if SNITCH_WITH_TIMINGS
     float duration = 0.0f;
+#endif
+    // What the test case wrote to the standard output and error, if it failed while
+    // registry::capture_output was set; the end of the output is kept if it was too long.
+    std::string_view output = {};
+};
+
+struct section_started {
+    const test_id& id;
+    // Sections currently entered; the last one is the section that started.
+    section_info sections = {};
+};
+
+struct section_ended {
+    const test_id& id;
+    // Sections currently entered; the last one is the section that ended.
+    section_info sections = {};
+#if SNITCH_WITH_TIMINGS
+    float duration = 0.0f;
 #endif
 };
 
@@ -1118,6 +1781,20 @@ struct assertion_failed {
     bool                      allowed  = false;
 };
 
+// Only reported with SNITCH_WITH_ASSERTION_EVENTS.
+struct assertion_passed {
+    const test_id&            id;
+    section_info              sections = {};
+    capture_info              captures = {};
+    const assertion_location& location;
+};
+
+struct assertion_failures_suppressed {
+    const test_id&            id;
+    const assertion_location& location;
+    std::size_t               count = 0;
+};
+
 struct test_case_skipped {
     const test_id&            id;
     section_info              sections = {};
@@ -1131,9 +1808,38 @@ using data = std::variant<
     test_run_ended,
     test_case_started,
     test_case_ended,
+    section_started,
+    section_ended,
     assertion_failed,
+    assertion_passed,
+    assertion_failures_suppressed,
     test_case_skipped>;
 }; // namespace event
+
+// Owning copy of an event. All the data referenced by the event (strings, test ID, location,
+// sections and captures) is copied into storage owned by this object; strings which do not fit
+// in the storage are truncated, and only the first `max_nested_sections` sections and
+// `max_captures` captures are kept. The copy cannot be moved, since the event refers to its
+// storage.
+class event_copy {
+    small_string<max_event_copy_length>           strings;
+    test_id                                       id;
+    assertion_location                            location;
+    small_vector<section_id, max_nested_sections> sections;
+    small_vector<std::string_view, max_captures>  captures;
+    event::data                                   data = event::test_run_started{};
+
+public:
+    event_copy() noexcept                    = default;
+    event_copy(const event_copy&)            = delete;
+    event_copy& operator=(const event_copy&) = delete;
+
+    void assign(const event::data& e) noexcept;
+
+    const event::data& get() const noexcept {
+        return data;
+    }
+};
 } // namespace snitch
 
 // Command line interface.
@@ -1166,39 +1872,98 @@ get_positional_argument(const cli::input& args, std::string_view name) noexcept;
 
 namespace snitch {
 class registry {
-    small_vector<impl::test_case, max_test_cases> test_list;
-
-    void print_location(
-        const impl::test_case&     current_case,
-        const impl::section_state& sections,
-        const impl::capture_state& captures,
-        const assertion_location&  location) const noexcept;
-
-    void print_failure() const noexcept;
-    void print_expected_failure() const noexcept;
-    void print_skip() const noexcept;
-    void print_details(std::string_view message) const noexcept;
-    void print_details_expr(const impl::expression& exp) const noexcept;
-
 public:
-    enum class verbosity { quiet, normal, high } verbose = verbosity::normal;
-    bool with_color                                      = true;
-
     using print_function  = small_function<void(std::string_view) noexcept>;
     using report_function = small_function<void(const registry&, const event::data&) noexcept>;
 
-    print_function  print_callback = &snitch::impl::stdout_print;
-    report_function report_callback;
+    // Creates a reporter writing to the given file. If the file is null, the reporter writes to
+    // its default output: impl::stdout_file() for reporters made with impl::make_reporter(), or
+    // print_callback for reporters which only use print().
+    using reporter_factory = report_function (*)(std::FILE* output) noexcept;
 
-    template<typename... Args>
+private:
+    struct registered_reporter {
+        std::string_view name    = {};
+        reporter_factory factory = nullptr;
+    };
+
+    struct selected_reporter {
+        std::string_view name     = {};
+        report_function  callback = {};
+        std::FILE*       output   = nullptr;
+    };
+
+    // Test cases are chained in a list, in the order they were added. Test cases added with
+    // add(id, func) are stored in test_storage; the others are owned by the caller.
+    impl::test_case*                                 first_test = nullptr;
+    impl::test_case*                                 last_test  = nullptr;
+    small_vector<impl::test_case, max_test_cases>    test_storage;
+    small_vector<registered_reporter, max_reporters> registered_reporters;
+    small_vector<selected_reporter, max_reporters>   selected_reporters;
+
+public:
+    constexpr registry() noexcept = default;
+
+    // The test cases are chained through pointers to the registry's own storage, so a registry
+    // cannot be copied or moved.
+    registry(const registry&)            = delete;
+    registry(registry&&)                 = delete;
+    registry& operator=(const registry&) = delete;
+    registry& operator=(registry&&)      = delete;
+
+    enum class verbosity { quiet, normal, high } verbose = verbosity::normal;
+    bool with_color                                      = SNITCH_DEFAULT_WITH_COLOR == 1;
+
+    // Maximum number of failures reported for each check location in a test case;
+    // any further failure is only counted, and summarized when the test case ends.
+    // Zero means no limit.
+    std::size_t max_failures_per_site = 0;
+
+    // Redirect the standard output and error of the process while each test case runs, and
+    // only show what was written if the test case failed (POSIX platforms only).
+    bool capture_output = false;
+
+    print_function  print_callback = &snitch::impl::stdout_print;
+    report_function report_callback;
+
+    template<typename... Args>
     void print(Args&&... args) const noexcept {
         small_string<max_message_length> message;
         append_or_truncate(message, std::forward<Args>(args)...);
-        this->print_callback(message);
+        this->print_message(message);
     }
 
+    // Writes the message to the output of the reporter currently handling an event on this
+    // thread (see impl::get_current_output()), if it has one, or sends it to print_callback
+    // otherwise.
+    void print_message(std::string_view message) const noexcept;
+
+    // Makes a reporter available for selection by name, with select_reporter() or the
+    // `--reporter` command line option. Registering the same name and factory twice is allowed.
+    std::string_view add_reporter(std::string_view name, reporter_factory factory) noexcept;
+
+    // Adds a reporter to the list of reporters notified of each event. The specification is the
+    // reporter name, optionally followed by "::out=<file>" to write the report to a file rather
+    // than to the default output of the reporter. Once a reporter is selected, report_callback is
+    // no longer used.
+    // Returns false and prints an error if the reporter could not be selected.
+    bool select_reporter(std::string_view specification) noexcept;
+
+    // Closes the files opened by select_reporter(), and empties the list of selected reporters.
+    void clear_reporters() noexcept;
+
+    // Sends the event to all the selected reporters, or to report_callback if none is selected,
+    // or to the console reporter if report_callback is empty.
+    void report_event(const event::data& event) const noexcept;
+
+    // Adds a test case, stored in the registry. At most `SNITCH_MAX_TEST_CASES` test cases can
+    // be added this way; the test case macros use the overloads below instead.
     const char* add(const test_id& id, impl::test_ptr func) noexcept;
 
+    // Adds a test case stored by the caller, which must outlive the registry, and must not be
+    // added to another registry. This does not require any storage from the registry.
+    const char* add(impl::test_case& test) noexcept;
+
     template<typename... Args, typename F>
     const char*
     add_with_types(std::string_view name, std::string_view tags, const F& func) noexcept {
@@ -1207,6 +1972,19 @@ public:
             ...);
     }
 
+    template<typename... Args, typename F>
+    const char* add_with_types(
+        impl::typed_test_cases<Args...>& tests,
+        std::string_view                 name,
+        std::string_view                 tags,
+        const F&                         func) noexcept {
+        impl::test_case* test = tests;
+        return (
+            (*test = {{name, tags, impl::get_type_name<Args>()}, impl::to_test_case_ptr<Args>(func)},
+             add(*test++)),
+            ...);
+    }
+
     template<typename T, typename F>
     const char*
     add_with_type_list(std::string_view name, std::string_view tags, const F& func) noexcept {
@@ -1215,6 +1993,17 @@ public:
         }(type_list<T>{});
     }
 
+    template<typename T, typename F>
+    const char* add_with_type_list(
+        impl::type_list_test_cases<T>& tests,
+        std::string_view               name,
+        std::string_view               tags,
+        const F&                       func) noexcept {
+        return [&]<template<typename...> typename TL, typename... Args>(type_list<TL<Args...>>) {
+            return this->add_with_types<Args...>(tests, name, tags, func);
+        }(type_list<T>{});
+    }
+
     void report_failure(
         impl::test_state&         state,
         const assertion_location& location,
@@ -1236,6 +2025,9 @@ public:
         const assertion_location& location,
         std::string_view          message) const noexcept;
 
+    void report_assertion_passed(
+        impl::test_state& state, const assertion_location& location) const noexcept;
+
     impl::test_state run(impl::test_case& test) noexcept;
 
     bool run_all_tests(std::string_view run_name) noexcept;
@@ -1244,21 +2036,63 @@ public:
 
     bool run_tests(const cli::input& args) noexcept;
 
-    void configure(const cli::input& args) noexcept;
+    // Applies the command line options. Returns false if a reporter given with `--reporter`
+    // could not be selected; the reason is printed.
+    bool configure(const cli::input& args) noexcept;
 
     void list_all_tests() const noexcept;
     void list_all_tags() const noexcept;
     void list_tests_with_tag(std::string_view tag) const noexcept;
 
-    impl::test_case*       begin() noexcept;
-    impl::test_case*       end() noexcept;
-    const impl::test_case* begin() const noexcept;
-    const impl::test_case* end() const noexcept;
+    impl::test_case_iterator<impl::test_case>       begin() noexcept;
+    impl::test_case_iterator<impl::test_case>       end() noexcept;
+    impl::test_case_iterator<const impl::test_case> begin() const noexcept;
+    impl::test_case_iterator<const impl::test_case> end() const noexcept;
 };
 
 extern constinit registry tests;
 } // namespace snitch
 
+// Assertion coverage.
+// -------------------
+
+namespace snitch {
+// Writes which assertion sites were executed so far, for merging with other runs of the same
+// program (for example, other shards of the test suite) with the snitch_coverage tool. Returns
+// false if SNITCH_WITH_ASSERTION_EVENTS is disabled, if writing failed, or if the program has
+// more than max_assertion_sites sites; in the latter case, the file lists only the first ones.
+//
+// The format is binary, with integers stored as LEB128 varints:
+//  - the magic "SNCV" and the format version (1), in five bytes,
+//  - the number of source files, then the length and characters of each file name,
+//  - the number of sites, then the file index and line of each site,
+//  - one bit per site, least significant bit first, set if the site was executed.
+bool write_assertion_coverage(std::FILE* file) noexcept;
+} // namespace snitch
+
+// Default reporter.
+// -----------------
+
+namespace snitch::console {
+// Prints the event in the default, human-readable format; this is what the registry does
+// when no report_callback is set.
+void report(const registry& r, const event::data& event) noexcept;
+} // namespace snitch::console
+
+namespace snitch::impl {
+template<typename T>
+inline std::optional<T> reporter_instance;
+
+// Reporter factory for classes constructed from their output file, with a report() function;
+// without a file, they write to stdout_file(). Each class has a single instance, hence can only
+// be selected once at a time.
+template<typename T>
+registry::report_function make_reporter(std::FILE* output) noexcept {
+    T& reporter = reporter_instance<T>.emplace(output != nullptr ? output : stdout_file());
+    return {reporter, constant<&T::report>{}};
+}
+} // namespace snitch::impl
+
 // Matchers.
 // ---------
 
@@ -1274,14 +2108,21 @@ struct contains_substring {
     describe_match(std::string_view message, match_status status) const noexcept;
 };
 
-template<typename T, std::size_t N>
-struct is_any_of {
-    small_vector<T, N> list;
+} // namespace snitch::matchers
 
-    template<typename... Args>
-    explicit is_any_of(const Args&... args) noexcept : list({args...}) {}
+namespace snitch::impl {
+// Number of candidates up to which is_any_of scans its list linearly. Beyond this, the candidates
+// are stored in a lookup table when the type allows it.
+constexpr std::size_t is_any_of_linear_max = 16u;
+
+template<typename T>
+concept hashable_constant = std::is_integral_v<T> || std::is_enum_v<T>;
+
+template<typename T, std::size_t N>
+struct linear_lookup {
+    constexpr explicit linear_lookup(const small_vector<T, N>&) noexcept {}
 
-    bool match(const T& value) const noexcept {
+    constexpr bool contains(const small_vector<T, N>& list, const T& value) const noexcept {
         for (const auto& v : list) {
             if (v == value) {
                 return true;
@@ -1290,6 +2131,122 @@ struct is_any_of {
 
         return false;
     }
+};
+
+// Candidates sorted on construction, looked up with a binary search.
+template<typename T, std::size_t N>
+struct sorted_lookup {
+    std::array<T, N> sorted = {};
+    std::size_t      count  = 0u;
+
+    constexpr explicit sorted_lookup(const small_vector<T, N>& list) noexcept :
+        count(list.size()) {
+        // Shell sort: no dependency on <algorithm>, and usable in constant expressions.
+        for (std::size_t i = 0; i < count; ++i) {
+            sorted[i] = list[i];
+        }
+
+        for (std::size_t gap = count / 2u; gap > 0u; gap /= 2u) {
+            for (std::size_t i = gap; i < count; ++i) {
+                T           v = sorted[i];
+                std::size_t j = i;
+                for (; j >= gap && v < sorted[j - gap]; j -= gap) {
+                    sorted[j] = sorted[j - gap];
+                }
+                sorted[j] = v;
+            }
+        }
+    }
+
+    constexpr bool contains(const small_vector<T, N>&, const T& value) const noexcept {
+        std::size_t first = 0u;
+        std::size_t last  = count;
+        while (first < last) {
+            const std::size_t middle = first + (last - first) / 2u;
+            if (sorted[middle] < value) {
+                first = middle + 1u;
+            } else {
+                last = middle;
+            }
+        }
+
+        return first < count && sorted[first] == value;
+    }
+};
+
+// Candidates stored in an open-addressing hash table, with at most half of the slots occupied.
+template<typename T, std::size_t N>
+struct hashed_lookup {
+    static constexpr std::size_t slot_bits = []() {
+        std::size_t bits = 1u;
+        while ((std::size_t{1u} << bits) < 2u * N) {
+            ++bits;
+        }
+        return bits;
+    }();
+
+    static constexpr std::size_t slot_count = std::size_t{1u} << slot_bits;
+
+    std::array<T, slot_count>    slots = {};
+    std::array<bool, slot_count> used  = {};
+
+    static constexpr std::size_t hash(const T& value) noexcept {
+        std::uint64_t key = 0u;
+        if constexpr (std::is_enum_v<T>) {
+            key = static_cast<std::uint64_t>(static_cast<std::underlying_type_t<T>>(value));
+        } else {
+            key = static_cast<std::uint64_t>(value);
+        }
+
+        // Fibonacci hashing: keeps the high bits of the product.
+        return static_cast<std::size_t>((key * 0x9e3779b97f4a7c15u) >> (64u - slot_bits));
+    }
+
+    constexpr explicit hashed_lookup(const small_vector<T, N>& list) noexcept {
+        for (const auto& v : list) {
+            std::size_t i = hash(v);
+            while (used[i] && slots[i] != v) {
+                i = (i + 1u) & (slot_count - 1u);
+            }
+
+            slots[i] = v;
+            used[i]  = true;
+        }
+    }
+
+    constexpr bool contains(const small_vector<T, N>&, const T& value) const noexcept {
+        for (std::size_t i = hash(value); used[i]; i = (i + 1u) & (slot_count - 1u)) {
+            if (slots[i] == value) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+};
+
+template<typename T, std::size_t N>
+using any_of_lookup = std::conditional_t<
+    (N <= is_any_of_linear_max),
+    linear_lookup<T, N>,
+    std::conditional_t<
+        hashable_constant<T>,
+        hashed_lookup<T, N>,
+        std::conditional_t<std::totally_ordered<T>, sorted_lookup<T, N>, linear_lookup<T, N>>>>;
+} // namespace snitch::impl
+
+namespace snitch::matchers {
+template<typename T, std::size_t N>
+struct is_any_of {
+    small_vector<T, N>        list;
+    impl::any_of_lookup<T, N> lookup;
+
+    template<typename... Args>
+    constexpr explicit is_any_of(const Args&... args) noexcept : list({args...}), lookup(list) {}
+
+    constexpr bool match(const T& value) const noexcept {
+        return lookup.contains(list, value);
+    }
 
     small_string<max_message_length>
     describe_match(const T& value, match_status status) const noexcept {
@@ -1331,6 +2288,381 @@ struct with_what_contains : private contains_substring {
     }
 };
 
+} // namespace snitch::matchers
+
+namespace snitch::impl {
+// Maximum number of mismatching indices listed by the range matchers.
+constexpr std::size_t max_listed_mismatches = 5u;
+
+template<typename T>
+concept numeric = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+// Counts the elements for which `differs` returns true. `differs` must not branch, so that the
+// loop can be vectorised by the compiler.
+template<typename T, typename F>
+std::size_t count_mismatches(
+    std::span<const T> values, std::span<const T> expected, const F& differs) noexcept {
+    const T* const    v     = values.data();
+    const T* const    e     = expected.data();
+    const std::size_t size  = values.size();
+    std::size_t       count = 0u;
+    for (std::size_t i = 0; i < size; ++i) {
+        count += static_cast<std::size_t>(differs(v[i], e[i]));
+    }
+
+    return count;
+}
+
+template<typename T>
+concept ulp_comparable = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+template<ulp_comparable T>
+using ulp_type = std::conditional_t<std::is_same_v<T, float>, std::uint32_t, std::uint64_t>;
+
+template<typename T>
+constexpr T absolute_difference(T a, T b) noexcept {
+    return a > b ? a - b : b - a;
+}
+
+// Clears the sign bit; unlike a comparison and a negation, this does not prevent vectorisation.
+template<ulp_comparable T>
+constexpr T absolute_value(T value) noexcept {
+    constexpr ulp_type<T> sign = ulp_type<T>{1u} << (sizeof(T) * 8u - 1u);
+    return std::bit_cast<T>(std::bit_cast<ulp_type<T>>(value) & ~sign);
+}
+
+// Maps a floating point number to an unsigned integer, such that adjacent numbers are adjacent
+// integers. Positive and negative zeros are mapped to the same integer.
+template<ulp_comparable T>
+constexpr ulp_type<T> ordered_bits(T value) noexcept {
+    constexpr ulp_type<T> sign = ulp_type<T>{1u} << (sizeof(T) * 8u - 1u);
+    const ulp_type<T>     bits = std::bit_cast<ulp_type<T>>(value);
+    return (bits & sign) != 0u ? sign - (bits & ~sign) : sign + bits;
+}
+
+// Number of representable numbers between `a` and `b`. Meaningless if either is a NaN.
+template<ulp_comparable T>
+constexpr ulp_type<T> raw_ulp_distance(T a, T b) noexcept {
+    return absolute_difference(ordered_bits(a), ordered_bits(b));
+}
+
+template<ulp_comparable T>
+constexpr std::uint64_t ulp_distance(T a, T b) noexcept {
+    return a != a || b != b ? std::numeric_limits<std::uint64_t>::max() : raw_ulp_distance(a, b);
+}
+
+// Describes the mismatches found by `differs`, and the largest `error` among them. Only used to
+// report failures, so this does not need to be fast.
+template<typename T, typename Differs, typename Error>
+small_string<max_message_length> describe_range_match(
+    std::span<const T>     values,
+    std::span<const T>     expected,
+    matchers::match_status status,
+    const Differs&         differs,
+    const Error&           error,
+    std::string_view       error_unit) noexcept {
+    small_string<max_message_length> description;
+    if (values.size() != expected.size()) {
+        append_or_truncate(
+            description, "range has ", values.size(), " elements, expected ", expected.size());
+        return description;
+    }
+
+    if (status == matchers::match_status::matched) {
+        append_or_truncate(description, "all ", values.size(), " elements match");
+        return description;
+    }
+
+    using error_type = decltype(error(values[0], expected[0]));
+
+    std::size_t count         = 0u;
+    std::size_t max_index     = 0u;
+    error_type  max_error     = {};
+    bool        first_listed  = true;
+    bool        truncate_list = false;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (!differs(values[i], expected[i])) {
+            continue;
+        }
+
+        // A NaN error is reported as the largest error.
+        const error_type e = error(values[i], expected[i]);
+        if (count == 0u || (max_error == max_error && (e > max_error || e != e))) {
+            max_error = e;
+            max_index = i;
+        }
+
+        if (count < max_listed_mismatches) {
+            append_or_truncate(description, first_listed ? "" : ", ", i);
+            first_listed = false;
+        } else {
+            truncate_list = true;
+        }
+
+        ++count;
+    }
+
+    small_string<max_message_length> header;
+    append_or_truncate(
+        header, count, " of ", values.size(), " elements differ, at indices ", description.str(),
+        truncate_list ? ", ...; " : "; ", "max error ", max_error, error_unit, " at index ",
+        max_index, " (got ", values[max_index], ", expected ", expected[max_index], ")");
+    return header;
+}
+} // namespace snitch::impl
+
+namespace snitch::matchers {
+// Checks that a contiguous range of numbers is exactly equal to another, element by element.
+// The expected range is not copied, and must outlive the matcher.
+template<impl::numeric T>
+struct equals_range {
+    std::span<const T> expected;
+
+    constexpr explicit equals_range(std::span<const T> e) noexcept : expected(e) {}
+
+    static constexpr bool differs(T a, T b) noexcept {
+        return a != b;
+    }
+
+    static constexpr auto error(T a, T b) noexcept {
+        if constexpr (std::is_floating_point_v<T>) {
+            return impl::absolute_difference(a, b);
+        } else {
+            // Subtract in unsigned arithmetic, which cannot overflow.
+            return a > b ? static_cast<std::uint64_t>(a) - static_cast<std::uint64_t>(b)
+                         : static_cast<std::uint64_t>(b) - static_cast<std::uint64_t>(a);
+        }
+    }
+
+    bool match(std::span<const T> values) const noexcept {
+        return values.size() == expected.size() &&
+               impl::count_mismatches(values, expected, &differs) == 0u;
+    }
+
+    small_string<max_message_length>
+    describe_match(std::span<const T> values, match_status status) const noexcept {
+        return impl::describe_range_match(values, expected, status, &differs, &error, "");
+    }
+};
+
+template<typename R>
+equals_range(const R&) -> equals_range<impl::range_element_t<R>>;
+
+// Checks that two contiguous ranges of floating point numbers are element-wise close, with the
+// same definition as Python's `math.isclose`: `|a - b| <= max(rel_tol * max(|a|, |b|), abs_tol)`.
+// Equal infinities are close, NaNs are never close. The expected range is not copied, and must
+// outlive the matcher.
+template<impl::ulp_comparable T>
+struct all_close {
+    std::span<const T> expected;
+    T                  rel_tol = 0;
+    T                  abs_tol = 0;
+
+    constexpr explicit all_close(std::span<const T> e, T rel, T abs = T{0}) noexcept :
+        expected(e), rel_tol(rel), abs_tol(abs) {}
+
+    constexpr bool differs(T a, T b) const noexcept {
+        const T abs_a     = impl::absolute_value(a);
+        const T abs_b     = impl::absolute_value(b);
+        const T magnitude = abs_a > abs_b ? abs_a : abs_b;
+        const T rel       = rel_tol * magnitude;
+        const T tolerance = rel > abs_tol ? rel : abs_tol;
+        const T diff      = impl::absolute_value(a - b);
+        // Bitwise operators rather than short-circuiting ones, so the loop can be vectorised.
+        return !((a == b) | ((diff <= tolerance) & (diff < std::numeric_limits<T>::infinity())));
+    }
+
+    bool match(std::span<const T> values) const noexcept {
+        return values.size() == expected.size() &&
+               impl::count_mismatches(
+                   values, expected, [this](T a, T b) { return differs(a, b); }) == 0u;
+    }
+
+    small_string<max_message_length>
+    describe_match(std::span<const T> values, match_status status) const noexcept {
+        return impl::describe_range_match(
+            values, expected, status, [this](T a, T b) { return differs(a, b); },
+            [](T a, T b) { return impl::absolute_value(a - b); }, "");
+    }
+};
+
+template<typename R, typename T>
+all_close(const R&, T, T) -> all_close<impl::range_element_t<R>>;
+template<typename R, typename T>
+all_close(const R&, T) -> all_close<impl::range_element_t<R>>;
+
+// Checks that two contiguous ranges of floating point numbers are element-wise within `max_ulp`
+// representable numbers of each other. Positive and negative zeros are equal, NaNs never match.
+// The expected range is not copied, and must outlive the matcher.
+template<impl::ulp_comparable T>
+struct within_ulp {
+    std::span<const T> expected;
+    std::uint64_t      max_ulp = 0u;
+
+    constexpr explicit within_ulp(std::span<const T> e, std::uint64_t ulp) noexcept :
+        expected(e), max_ulp(ulp) {}
+
+    constexpr bool differs(T a, T b) const noexcept {
+        using ulp_type              = impl::ulp_type<T>;
+        constexpr auto max_ulp_type = std::numeric_limits<ulp_type>::max();
+        const ulp_type limit =
+            max_ulp > max_ulp_type ? max_ulp_type : static_cast<ulp_type>(max_ulp);
+
+        // Bitwise operators rather than short-circuiting ones, so the loop can be vectorised.
+        return (a != a) | (b != b) | (impl::raw_ulp_distance(a, b) > limit);
+    }
+
+    bool match(std::span<const T> values) const noexcept {
+        return values.size() == expected.size() &&
+               impl::count_mismatches(
+                   values, expected, [this](T a, T b) { return differs(a, b); }) == 0u;
+    }
+
+    small_string<max_message_length>
+    describe_match(std::span<const T> values, match_status status) const noexcept {
+        return impl::describe_range_match(
+            values, expected, status, [this](T a, T b) { return differs(a, b); },
+            &impl::ulp_distance<T>, " ulp");
+    }
+};
+
+template<typename R>
+within_ulp(const R&, std::uint64_t) -> within_ulp<impl::range_element_t<R>>;
+
+// Combination of two matchers, which matches if both match. The second matcher is not evaluated
+// if the first one does not match.
+template<typename M1, typename M2>
+struct logical_and {
+    M1 first;
+    M2 second;
+
+    template<typename T>
+        requires matcher_for<M1, T> && matcher_for<M2, T>
+    constexpr bool match(const T& value) const noexcept {
+        return first.match(value) && second.match(value);
+    }
+
+    template<typename T>
+        requires matcher_for<M1, T> && matcher_for<M2, T>
+    small_string<max_message_length>
+    describe_match(const T& value, match_status status) const noexcept {
+        small_string<max_message_length> description;
+        if (status == match_status::failed) {
+            // Only describe the matcher that failed.
+            if (!first.match(value)) {
+                append_or_truncate(description, first.describe_match(value, status));
+            } else {
+                append_or_truncate(description, second.describe_match(value, status));
+            }
+        } else {
+            append_or_truncate(
+                description, first.describe_match(value, status), " and ",
+                second.describe_match(value, status));
+        }
+
+        return description;
+    }
+};
+
+// Combination of two matchers, which matches if either matches. The second matcher is not
+// evaluated if the first one matches.
+template<typename M1, typename M2>
+struct logical_or {
+    M1 first;
+    M2 second;
+
+    template<typename T>
+        requires matcher_for<M1, T> && matcher_for<M2, T>
+    constexpr bool match(const T& value) const noexcept {
+        return first.match(value) || second.match(value);
+    }
+
+    template<typename T>
+        requires matcher_for<M1, T> && matcher_for<M2, T>
+    small_string<max_message_length>
+    describe_match(const T& value, match_status status) const noexcept {
+        small_string<max_message_length> description;
+        if (status == match_status::matched) {
+            // Only describe the matcher that matched.
+            if (first.match(value)) {
+                append_or_truncate(description, first.describe_match(value, status));
+            } else {
+                append_or_truncate(description, second.describe_match(value, status));
+            }
+        } else {
+            append_or_truncate(
+                description, first.describe_match(value, status), " and ",
+                second.describe_match(value, status));
+        }
+
+        return description;
+    }
+};
+
+// Matches if the wrapped matcher does not match.
+template<typename M>
+struct logical_not {
+    M matcher;
+
+    template<typename T>
+        requires matcher_for<M, T>
+    constexpr bool match(const T& value) const noexcept {
+        return !matcher.match(value);
+    }
+
+    template<typename T>
+        requires matcher_for<M, T>
+    small_string<max_message_length>
+    describe_match(const T& value, match_status status) const noexcept {
+        small_string<max_message_length> description;
+        append_or_truncate(
+            description,
+            matcher.describe_match(
+                value, status == match_status::failed ? match_status::matched
+                                                      : match_status::failed));
+        return description;
+    }
+};
+
+} // namespace snitch::matchers
+
+namespace snitch::impl {
+struct matcher_members {
+    void match() noexcept;
+    void describe_match() noexcept;
+};
+
+// Derives from both T and matcher_members, so the lookup of `match` or `describe_match` is
+// ambiguous if T has a member with the same name.
+template<typename T>
+struct matcher_member_probe : T, matcher_members {};
+} // namespace snitch::impl
+
+namespace snitch::matchers {
+// Classes with `match` and `describe_match` members. Their signatures are not checked, since
+// they are usually templates, but other classes which happen to be found by argument-dependent
+// lookup (like std::optional<match_status>) are excluded.
+template<typename T>
+concept matcher = std::is_class_v<T> && !std::is_final_v<T> &&
+                  !requires { &impl::matcher_member_probe<T>::match; } &&
+                  !requires { &impl::matcher_member_probe<T>::describe_match; };
+
+// Combinators, for any matcher defined in this namespace.
+template<matcher M1, matcher M2>
+constexpr logical_and<M1, M2> operator&&(const M1& m1, const M2& m2) noexcept {
+    return {m1, m2};
+}
+
+template<matcher M1, matcher M2>
+constexpr logical_or<M1, M2> operator||(const M1& m1, const M2& m2) noexcept {
+    return {m1, m2};
+}
+
+template<matcher M>
+constexpr logical_not<M> operator!(const M& m) noexcept {
+    return {m};
+}
+
 template<typename T, matcher_for<T> M>
 bool operator==(const T& value, const M& m) noexcept {
     return m.match(value);
@@ -1379,6 +2711,16 @@ bool operator==(const M& m, const T& value) noexcept {
 #    define SNITCH_TESTING_ABORT std::terminate()
 #endif
 
+#if SNITCH_WITH_ASSERTION_EVENTS
+#    define SNITCH_ASSERTION_SITE()                                                                \
+        snitch::impl::mark_assertion_site(snitch::impl::assertion_site<__FILE__, __LINE__>::index)
+#    define SNITCH_ASSERTION_PASSED(TEST)                                                          \
+        TEST.reg.report_assertion_passed(TEST, {__FILE__, __LINE__})
+#else
+#    define SNITCH_ASSERTION_SITE() static_cast<void>(0)
+#    define SNITCH_ASSERTION_PASSED(TEST) static_cast<void>(0)
+#endif
+
 #define SNITCH_CONCAT_IMPL(x, y) x##y
 #define SNITCH_MACRO_CONCAT(x, y) SNITCH_CONCAT_IMPL(x, y)
 
@@ -1394,24 +2736,60 @@ bool operator==(const M& m, const T& value) noexcept {
     snitch::impl::is_decomposable<                                                                 \
         decltype(snitch::impl::expression_extractor<true, true>{std::declval<snitch::impl::expression&>()} <= EXP)>
 
+#define SNITCH_CONSTANT_EXPR(TYPE, EXPECTED, EXP)                                                  \
+    [&]() {                                                                                        \
+        snitch::impl::constant_check_result SNITCH_CONSTANT_RESULT{                                \
+            false, {TYPE "(" #EXP ")", {}}};                                                       \
+        SNITCH_WARNING_PUSH                                                                        \
+        SNITCH_WARNING_DISABLE_PARENTHESES                                                         \
+        SNITCH_WARNING_DISABLE_CONSTANT_COMPARISON                                                 \
+        if constexpr (SNITCH_DECOMPOSABLE(EXP)) {                                                  \
+            SNITCH_CONSTANT_RESULT.failed = static_cast<bool>(                                     \
+                snitch::impl::expression_extractor<false, EXPECTED>{SNITCH_CONSTANT_RESULT.expr}   \
+                <= EXP);                                                                           \
+        } else {                                                                                   \
+            SNITCH_CONSTANT_RESULT.failed = static_cast<bool>(EXP) != EXPECTED;                    \
+        }                                                                                          \
+        SNITCH_WARNING_POP                                                                         \
+        return SNITCH_CONSTANT_RESULT;                                                             \
+    }()
+
 // Public test macros: test cases.
 // -------------------------------
 
 #define SNITCH_TEST_CASE_IMPL(ID, ...)                                                             \
-    static void        ID();                                                                       \
+    static void                    ID();                                                           \
+    static snitch::impl::test_case SNITCH_MACRO_CONCAT(ID, _case){{__VA_ARGS__}, &ID};             \
     static const char* SNITCH_MACRO_CONCAT(test_id_, __COUNTER__) [[maybe_unused]] =               \
-        snitch::tests.add({__VA_ARGS__}, &ID);                                                     \
+        snitch::tests.add(SNITCH_MACRO_CONCAT(ID, _case));                                         \
     void ID()
 
 #define SNITCH_TEST_CASE(...)                                                                      \
     SNITCH_TEST_CASE_IMPL(SNITCH_MACRO_CONCAT(test_fun_, __COUNTER__), __VA_ARGS__)
 
+#define SNITCH_REGISTER_REPORTER(NAME, TYPE)                                                       \
+    static const std::string_view SNITCH_MACRO_CONCAT(reporter_id_, __COUNTER__)                   \
+        [[maybe_unused]] = snitch::tests.add_reporter(NAME, &snitch::impl::make_reporter<TYPE>)
+
+#define SNITCH_CONSTEXPR_TEST_CASE_IMPL(ID, ...)                                                   \
+    static constexpr void          ID();                                                           \
+    static snitch::impl::test_case SNITCH_MACRO_CONCAT(ID, _case){                                 \
+        {__VA_ARGS__}, &snitch::impl::run_constexpr_test_case<&ID>};                               \
+    static const char* SNITCH_MACRO_CONCAT(test_id_, __COUNTER__) [[maybe_unused]] =               \
+        snitch::tests.add(SNITCH_MACRO_CONCAT(ID, _case));                                         \
+    static constexpr void ID()
+
+#define SNITCH_CONSTEXPR_TEST_CASE(...)                                                            \
+    SNITCH_CONSTEXPR_TEST_CASE_IMPL(SNITCH_MACRO_CONCAT(test_fun_, __COUNTER__), __VA_ARGS__)
+
 #define SNITCH_TEMPLATE_LIST_TEST_CASE_IMPL(ID, NAME, TAGS, TYPES)                                 \
     template<typename TestType>                                                                    \
-    static void        ID();                                                                       \
+    static void                                       ID();                                        \
+    static snitch::impl::type_list_test_cases<TYPES> SNITCH_MACRO_CONCAT(ID, _cases);              \
     static const char* SNITCH_MACRO_CONCAT(test_id_, __COUNTER__) [[maybe_unused]] =               \
         snitch::tests.add_with_type_list<TYPES>(                                                   \
-            NAME, TAGS, []<typename TestType>() { ID<TestType>(); });                              \
+            SNITCH_MACRO_CONCAT(ID, _cases), NAME, TAGS,                                           \
+            []<typename TestType>() { ID<TestType>(); });                                          \
     template<typename TestType>                                                                    \
     void ID()
 
@@ -1421,10 +2799,12 @@ bool operator==(const M& m, const T& value) noexcept {
 
 #define SNITCH_TEMPLATE_TEST_CASE_IMPL(ID, NAME, TAGS, ...)                                        \
     template<typename TestType>                                                                    \
-    static void        ID();                                                                       \
+    static void                                         ID();                                      \
+    static snitch::impl::typed_test_cases<__VA_ARGS__> SNITCH_MACRO_CONCAT(ID, _cases);            \
     static const char* SNITCH_MACRO_CONCAT(test_id_, __COUNTER__) [[maybe_unused]] =               \
         snitch::tests.add_with_types<__VA_ARGS__>(                                                 \
-            NAME, TAGS, []<typename TestType>() { ID<TestType>(); });                              \
+            SNITCH_MACRO_CONCAT(ID, _cases), NAME, TAGS,                                           \
+            []<typename TestType>() { ID<TestType>(); });                                          \
     template<typename TestType>                                                                    \
     void ID()
 
@@ -1438,8 +2818,10 @@ bool operator==(const M& m, const T& value) noexcept {
         void test_fun();                                                                           \
     };                                                                                             \
     }                                                                                              \
+    static snitch::impl::test_case SNITCH_MACRO_CONCAT(ID, _case){                                 \
+        {__VA_ARGS__}, []() { ID{}.test_fun(); }};                                                 \
     static const char* SNITCH_MACRO_CONCAT(test_id_, __COUNTER__) [[maybe_unused]] =               \
-        snitch::tests.add({__VA_ARGS__}, []() { ID{}.test_fun(); });                               \
+        snitch::tests.add(SNITCH_MACRO_CONCAT(ID, _case));                                         \
     void ID::test_fun()
 
 #define SNITCH_TEST_CASE_METHOD(FIXTURE, ...)                                                      \
@@ -1453,9 +2835,11 @@ bool operator==(const M& m, const T& value) noexcept {
         void test_fun();                                                                           \
     };                                                                                             \
     }                                                                                              \
+    static snitch::impl::type_list_test_cases<TYPES> SNITCH_MACRO_CONCAT(ID, _cases);              \
     static const char* SNITCH_MACRO_CONCAT(test_id_, __COUNTER__) [[maybe_unused]] =               \
-        snitch::tests.add_with_types<TYPES>(                                                       \
-            NAME, TAGS, []() < typename TestType > { ID<TestType>{}.test_fun(); });                \
+        snitch::tests.add_with_type_list<TYPES>(                                                   \
+            SNITCH_MACRO_CONCAT(ID, _cases), NAME, TAGS,                                           \
+            []<typename TestType>() { ID<TestType>{}.test_fun(); });                               \
     template<typename TestType>                                                                    \
     void ID<TestType>::test_fun()
 
@@ -1470,9 +2854,11 @@ bool operator==(const M& m, const T& value) noexcept {
         void test_fun();                                                                           \
     };                                                                                             \
     }                                                                                              \
+    static snitch::impl::typed_test_cases<__VA_ARGS__> SNITCH_MACRO_CONCAT(ID, _cases);            \
     static const char* SNITCH_MACRO_CONCAT(test_id_, __COUNTER__) [[maybe_unused]] =               \
         snitch::tests.add_with_types<__VA_ARGS__>(                                                 \
-            NAME, TAGS, []() < typename TestType > { ID<TestType>{}.test_fun(); });                \
+            SNITCH_MACRO_CONCAT(ID, _cases), NAME, TAGS,                                           \
+            []<typename TestType>() { ID<TestType>{}.test_fun(); });                               \
     template<typename TestType>                                                                    \
     void ID<TestType>::test_fun()
 
@@ -1500,22 +2886,31 @@ bool operator==(const M& m, const T& value) noexcept {
 
 #define SNITCH_REQUIRE(EXP)                                                                        \
     do {                                                                                           \
-        auto& SNITCH_CURRENT_TEST = snitch::impl::get_current_test();                              \
-        ++SNITCH_CURRENT_TEST.asserts;                                                             \
         SNITCH_WARNING_PUSH                                                                        \
         SNITCH_WARNING_DISABLE_PARENTHESES                                                         \
         SNITCH_WARNING_DISABLE_CONSTANT_COMPARISON                                                 \
-        if constexpr (SNITCH_DECOMPOSABLE(EXP)) {                                                  \
-            if (SNITCH_EXPR_TRUE("REQUIRE", EXP)) {                                                \
-                SNITCH_CURRENT_TEST.reg.report_failure(                                            \
-                    SNITCH_CURRENT_TEST, {__FILE__, __LINE__}, SNITCH_CURRENT_EXPRESSION);         \
-                SNITCH_TESTING_ABORT;                                                              \
-            }                                                                                      \
+        if (snitch::impl::is_constant_evaluated()) {                                               \
+            snitch::impl::constant_check(static_cast<bool>(EXP), "REQUIRE(" #EXP ")");             \
         } else {                                                                                   \
-            if (!(EXP)) {                                                                          \
-                SNITCH_CURRENT_TEST.reg.report_failure(                                            \
-                    SNITCH_CURRENT_TEST, {__FILE__, __LINE__}, "REQUIRE(" #EXP ")");               \
-                SNITCH_TESTING_ABORT;                                                              \
+            auto& SNITCH_CURRENT_TEST = snitch::impl::get_current_test();                          \
+            ++SNITCH_CURRENT_TEST.asserts;                                                         \
+            SNITCH_ASSERTION_SITE();                                                               \
+            if constexpr (SNITCH_DECOMPOSABLE(EXP)) {                                              \
+                if (SNITCH_EXPR_TRUE("REQUIRE", EXP)) {                                            \
+                    SNITCH_CURRENT_TEST.reg.report_failure(                                        \
+                        SNITCH_CURRENT_TEST, {__FILE__, __LINE__}, SNITCH_CURRENT_EXPRESSION);     \
+                    SNITCH_TESTING_ABORT;                                                          \
+                } else {                                                                           \
+                    SNITCH_ASSERTION_PASSED(SNITCH_CURRENT_TEST);                                  \
+                }                                                                                  \
+            } else {                                                                               \
+                if (!(EXP)) {                                                                      \
+                    SNITCH_CURRENT_TEST.reg.report_failure(                                        \
+                        SNITCH_CURRENT_TEST, {__FILE__, __LINE__}, "REQUIRE(" #EXP ")");           \
+                    SNITCH_TESTING_ABORT;                                                          \
+                } else {                                                                           \
+                    SNITCH_ASSERTION_PASSED(SNITCH_CURRENT_TEST);                                  \
+                }                                                                                  \
             }                                                                                      \
         }                                                                                          \
         SNITCH_WARNING_POP                                                                         \
@@ -1523,20 +2918,29 @@ bool operator==(const M& m, const T& value) noexcept {
 
 #define SNITCH_CHECK(EXP)                                                                          \
     do {                                                                                           \
-        auto& SNITCH_CURRENT_TEST = snitch::impl::get_current_test();                              \
-        ++SNITCH_CURRENT_TEST.asserts;                                                             \
         SNITCH_WARNING_PUSH                                                                        \
         SNITCH_WARNING_DISABLE_PARENTHESES                                                         \
         SNITCH_WARNING_DISABLE_CONSTANT_COMPARISON                                                 \
-        if constexpr (SNITCH_DECOMPOSABLE(EXP)) {                                                  \
-            if (SNITCH_EXPR_TRUE("CHECK", EXP)) {                                                  \
-                SNITCH_CURRENT_TEST.reg.report_failure(                                            \
-                    SNITCH_CURRENT_TEST, {__FILE__, __LINE__}, SNITCH_CURRENT_EXPRESSION);         \
-            }                                                                                      \
+        if (snitch::impl::is_constant_evaluated()) {                                               \
+            snitch::impl::constant_check(static_cast<bool>(EXP), "CHECK(" #EXP ")");               \
         } else {                                                                                   \
-            if (!(EXP)) {                                                                          \
-                SNITCH_CURRENT_TEST.reg.report_failure(                                            \
-                    SNITCH_CURRENT_TEST, {__FILE__, __LINE__}, "CHECK(" #EXP ")");                 \
+            auto& SNITCH_CURRENT_TEST = snitch::impl::get_current_test();                          \
+            ++SNITCH_CURRENT_TEST.asserts;                                                         \
+            SNITCH_ASSERTION_SITE();                                                               \
+            if constexpr (SNITCH_DECOMPOSABLE(EXP)) {                                              \
+                if (SNITCH_EXPR_TRUE("CHECK", EXP)) {                                              \
+                    SNITCH_CURRENT_TEST.reg.report_failure(                                        \
+                        SNITCH_CURRENT_TEST, {__FILE__, __LINE__}, SNITCH_CURRENT_EXPRESSION);     \
+                } else {                                                                           \
+                    SNITCH_ASSERTION_PASSED(SNITCH_CURRENT_TEST);                                  \
+                }                                                                                  \
+            } else {                                                                               \
+                if (!(EXP)) {                                                                      \
+                    SNITCH_CURRENT_TEST.reg.report_failure(                                        \
+                        SNITCH_CURRENT_TEST, {__FILE__, __LINE__}, "CHECK(" #EXP ")");             \
+                } else {                                                                           \
+                    SNITCH_ASSERTION_PASSED(SNITCH_CURRENT_TEST);                                  \
+                }                                                                                  \
             }                                                                                      \
         }                                                                                          \
         SNITCH_WARNING_POP                                                                         \
@@ -1544,22 +2948,31 @@ bool operator==(const M& m, const T& value) noexcept {
 
 #define SNITCH_REQUIRE_FALSE(EXP)                                                                  \
     do {                                                                                           \
-        auto& SNITCH_CURRENT_TEST = snitch::impl::get_current_test();                              \
-        ++SNITCH_CURRENT_TEST.asserts;                                                             \
         SNITCH_WARNING_PUSH                                                                        \
         SNITCH_WARNING_DISABLE_PARENTHESES                                                         \
         SNITCH_WARNING_DISABLE_CONSTANT_COMPARISON                                                 \
-        if constexpr (SNITCH_DECOMPOSABLE(EXP)) {                                                  \
-            if (SNITCH_EXPR_FALSE("REQUIRE_FALSE", EXP)) {                                         \
-                SNITCH_CURRENT_TEST.reg.report_failure(                                            \
-                    SNITCH_CURRENT_TEST, {__FILE__, __LINE__}, SNITCH_CURRENT_EXPRESSION);         \
-                SNITCH_TESTING_ABORT;                                                              \
-            }                                                                                      \
+        if (snitch::impl::is_constant_evaluated()) {                                               \
+            snitch::impl::constant_check(!static_cast<bool>(EXP), "REQUIRE_FALSE(" #EXP ")");      \
         } else {                                                                                   \
-            if (!(EXP)) {                                                                          \
-                SNITCH_CURRENT_TEST.reg.report_failure(                                            \
-                    SNITCH_CURRENT_TEST, {__FILE__, __LINE__}, "REQUIRE_FALSE(" #EXP ")");         \
-                SNITCH_TESTING_ABORT;                                                              \
+            auto& SNITCH_CURRENT_TEST = snitch::impl::get_current_test();                          \
+            ++SNITCH_CURRENT_TEST.asserts;                                                         \
+            SNITCH_ASSERTION_SITE();                                                               \
+            if constexpr (SNITCH_DECOMPOSABLE(EXP)) {                                              \
+                if (SNITCH_EXPR_FALSE("REQUIRE_FALSE", EXP)) {                                     \
+                    SNITCH_CURRENT_TEST.reg.report_failure(                                        \
+                        SNITCH_CURRENT_TEST, {__FILE__, __LINE__}, SNITCH_CURRENT_EXPRESSION);     \
+                    SNITCH_TESTING_ABORT;                                                          \
+                } else {                                                                           \
+                    SNITCH_ASSERTION_PASSED(SNITCH_CURRENT_TEST);                                  \
+                }                                                                                  \
+            } else {                                                                               \
+                if (!(EXP)) {                                                                      \
+                    SNITCH_CURRENT_TEST.reg.report_failure(                                        \
+                        SNITCH_CURRENT_TEST, {__FILE__, __LINE__}, "REQUIRE_FALSE(" #EXP ")");     \
+                    SNITCH_TESTING_ABORT;                                                          \
+                } else {                                                                           \
+                    SNITCH_ASSERTION_PASSED(SNITCH_CURRENT_TEST);                                  \
+                }                                                                                  \
             }                                                                                      \
         }                                                                                          \
         SNITCH_WARNING_POP                                                                         \
@@ -1567,20 +2980,93 @@ bool operator==(const M& m, const T& value) noexcept {
 
 #define SNITCH_CHECK_FALSE(EXP)                                                                    \
     do {                                                                                           \
+        SNITCH_WARNING_PUSH                                                                        \
+        SNITCH_WARNING_DISABLE_PARENTHESES                                                         \
+        SNITCH_WARNING_DISABLE_CONSTANT_COMPARISON                                                 \
+        if (snitch::impl::is_constant_evaluated()) {                                               \
+            snitch::impl::constant_check(!static_cast<bool>(EXP), "CHECK_FALSE(" #EXP ")");        \
+        } else {                                                                                   \
+            auto& SNITCH_CURRENT_TEST = snitch::impl::get_current_test();                          \
+            ++SNITCH_CURRENT_TEST.asserts;                                                         \
+            SNITCH_ASSERTION_SITE();                                                               \
+            if constexpr (SNITCH_DECOMPOSABLE(EXP)) {                                              \
+                if (SNITCH_EXPR_FALSE("CHECK_FALSE", EXP)) {                                       \
+                    SNITCH_CURRENT_TEST.reg.report_failure(                                        \
+                        SNITCH_CURRENT_TEST, {__FILE__, __LINE__}, SNITCH_CURRENT_EXPRESSION);     \
+                } else {                                                                           \
+                    SNITCH_ASSERTION_PASSED(SNITCH_CURRENT_TEST);                                  \
+                }                                                                                  \
+            } else {                                                                               \
+                if (!(EXP)) {                                                                      \
+                    SNITCH_CURRENT_TEST.reg.report_failure(                                        \
+                        SNITCH_CURRENT_TEST, {__FILE__, __LINE__}, "CHECK_FALSE(" #EXP ")");       \
+                } else {                                                                           \
+                    SNITCH_ASSERTION_PASSED(SNITCH_CURRENT_TEST);                                  \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+        SNITCH_WARNING_POP                                                                         \
+    } while (0)
+
+#define SNITCH_STATIC_REQUIRE(EXP)                                                                 \
+    do {                                                                                           \
+        static_assert(EXP, "STATIC_REQUIRE(" #EXP ")");                                            \
+        if (!snitch::impl::is_constant_evaluated()) {                                              \
+            auto& SNITCH_CURRENT_TEST = snitch::impl::get_current_test();                          \
+            ++SNITCH_CURRENT_TEST.asserts;                                                         \
+            SNITCH_ASSERTION_SITE();                                                               \
+            SNITCH_ASSERTION_PASSED(SNITCH_CURRENT_TEST);                                          \
+        }                                                                                          \
+    } while (0)
+
+#define SNITCH_STATIC_CHECK(EXP)                                                                   \
+    do {                                                                                           \
+        constexpr auto SNITCH_TEMP_RESULT = SNITCH_CONSTANT_EXPR("STATIC_CHECK", true, EXP);       \
+        if (snitch::impl::is_constant_evaluated()) {                                               \
+            snitch::impl::constant_check(!SNITCH_TEMP_RESULT.failed, "STATIC_CHECK(" #EXP ")");    \
+        } else {                                                                                   \
+            auto& SNITCH_CURRENT_TEST = snitch::impl::get_current_test();                          \
+            ++SNITCH_CURRENT_TEST.asserts;                                                         \
+            SNITCH_ASSERTION_SITE();                                                               \
+            if (SNITCH_TEMP_RESULT.failed) {                                                       \
+                SNITCH_CURRENT_TEST.reg.report_failure(                                            \
+                    SNITCH_CURRENT_TEST, {__FILE__, __LINE__}, SNITCH_TEMP_RESULT.expr);           \
+            } else {                                                                               \
+                SNITCH_ASSERTION_PASSED(SNITCH_CURRENT_TEST);                                      \
+            }                                                                                      \
+        }                                                                                          \
+    } while (0)
+
+#define SNITCH_CONSTEXPR_CHECK(EXP)                                                                \
+    do {                                                                                           \
+        constexpr auto SNITCH_TEMP_RESULT =                                                        \
+            SNITCH_CONSTANT_EXPR("CONSTEXPR_CHECK[compile-time]", true, EXP);                      \
         auto& SNITCH_CURRENT_TEST = snitch::impl::get_current_test();                              \
-        ++SNITCH_CURRENT_TEST.asserts;                                                             \
+        SNITCH_CURRENT_TEST.asserts += 2;                                                          \
+        SNITCH_ASSERTION_SITE();                                                                   \
+        if (SNITCH_TEMP_RESULT.failed) {                                                           \
+            SNITCH_CURRENT_TEST.reg.report_failure(                                                \
+                SNITCH_CURRENT_TEST, {__FILE__, __LINE__}, SNITCH_TEMP_RESULT.expr);               \
+        } else {                                                                                   \
+            SNITCH_ASSERTION_PASSED(SNITCH_CURRENT_TEST);                                          \
+        }                                                                                          \
         SNITCH_WARNING_PUSH                                                                        \
         SNITCH_WARNING_DISABLE_PARENTHESES                                                         \
         SNITCH_WARNING_DISABLE_CONSTANT_COMPARISON                                                 \
         if constexpr (SNITCH_DECOMPOSABLE(EXP)) {                                                  \
-            if (SNITCH_EXPR_FALSE("CHECK_FALSE", EXP)) {                                           \
+            if (SNITCH_EXPR_TRUE("CONSTEXPR_CHECK[run-time]", EXP)) {                              \
                 SNITCH_CURRENT_TEST.reg.report_failure(                                            \
                     SNITCH_CURRENT_TEST, {__FILE__, __LINE__}, SNITCH_CURRENT_EXPRESSION);         \
+            } else {                                                                               \
+                SNITCH_ASSERTION_PASSED(SNITCH_CURRENT_TEST);                                      \
             }                                                                                      \
         } else {                                                                                   \
             if (!(EXP)) {                                                                          \
                 SNITCH_CURRENT_TEST.reg.report_failure(                                            \
-                    SNITCH_CURRENT_TEST, {__FILE__, __LINE__}, "CHECK_FALSE(" #EXP ")");           \
+                    SNITCH_CURRENT_TEST, {__FILE__, __LINE__},                                     \
+                    "CONSTEXPR_CHECK[run-time](" #EXP ")");                                        \
+            } else {                                                                               \
+                SNITCH_ASSERTION_PASSED(SNITCH_CURRENT_TEST);                                      \
             }                                                                                      \
         }                                                                                          \
         SNITCH_WARNING_POP                                                                         \
@@ -1590,6 +3076,7 @@ bool operator==(const M& m, const T& value) noexcept {
     do {                                                                                           \
         auto& SNITCH_CURRENT_TEST = snitch::impl::get_current_test();                              \
         ++SNITCH_CURRENT_TEST.asserts;                                                             \
+        SNITCH_ASSERTION_SITE();                                                                   \
         SNITCH_CURRENT_TEST.reg.report_failure(                                                    \
             SNITCH_CURRENT_TEST, {__FILE__, __LINE__}, (MESSAGE));                                 \
         SNITCH_TESTING_ABORT;                                                                      \
@@ -1599,6 +3086,7 @@ bool operator==(const M& m, const T& value) noexcept {
     do {                                                                                           \
         auto& SNITCH_CURRENT_TEST = snitch::impl::get_current_test();                              \
         ++SNITCH_CURRENT_TEST.asserts;                                                             \
+        SNITCH_ASSERTION_SITE();                                                                   \
         SNITCH_CURRENT_TEST.reg.report_failure(                                                    \
             SNITCH_CURRENT_TEST, {__FILE__, __LINE__}, (MESSAGE));                                 \
     } while (0)
@@ -1615,13 +3103,17 @@ bool operator==(const M& m, const T& value) noexcept {
     do {                                                                                           \
         auto& SNITCH_CURRENT_TEST = snitch::impl::get_current_test();                              \
         ++SNITCH_CURRENT_TEST.asserts;                                                             \
+        SNITCH_ASSERTION_SITE();                                                                   \
         const auto& SNITCH_TEMP_VALUE   = (EXPR);                                                  \
         const auto& SNITCH_TEMP_MATCHER = (MATCHER);                                               \
         if (!SNITCH_TEMP_MATCHER.match(SNITCH_TEMP_VALUE)) {                                       \
             SNITCH_CURRENT_TEST.reg.report_failure(                                                \
                 SNITCH_CURRENT_TEST, {__FILE__, __LINE__},                                         \
-                SNITCH_TEMP_MATCHER.describe_fail(SNITCH_TEMP_VALUE));                             \
+                SNITCH_TEMP_MATCHER.describe_match(                                                \
+                    SNITCH_TEMP_VALUE, snitch::matchers::match_status::failed));                   \
             SNITCH_TESTING_ABORT;                                                                  \
+        } else {                                                                                   \
+            SNITCH_ASSERTION_PASSED(SNITCH_CURRENT_TEST);                                          \
         }                                                                                          \
     } while (0)
 
@@ -1629,12 +3121,16 @@ bool operator==(const M& m, const T& value) noexcept {
     do {                                                                                           \
         auto& SNITCH_CURRENT_TEST = snitch::impl::get_current_test();                              \
         ++SNITCH_CURRENT_TEST.asserts;                                                             \
+        SNITCH_ASSERTION_SITE();                                                                   \
         const auto& SNITCH_TEMP_VALUE   = (EXPR);                                                  \
         const auto& SNITCH_TEMP_MATCHER = (MATCHER);                                               \
         if (!SNITCH_TEMP_MATCHER.match(SNITCH_TEMP_VALUE)) {                                       \
             SNITCH_CURRENT_TEST.reg.report_failure(                                                \
                 SNITCH_CURRENT_TEST, {__FILE__, __LINE__},                                         \
-                SNITCH_TEMP_MATCHER.describe_fail(SNITCH_TEMP_VALUE));                             \
+                SNITCH_TEMP_MATCHER.describe_match(                                                \
+                    SNITCH_TEMP_VALUE, snitch::matchers::match_status::failed));                   \
+        } else {                                                                                   \
+            SNITCH_ASSERTION_PASSED(SNITCH_CURRENT_TEST);                                          \
         }                                                                                          \
     } while (0)
 
@@ -1643,6 +3139,7 @@ bool operator==(const M& m, const T& value) noexcept {
 #    define TEST_CASE(NAME, ...)                       SNITCH_TEST_CASE(NAME, __VA_ARGS__)
 #    define TEMPLATE_LIST_TEST_CASE(NAME, TAGS, TYPES) SNITCH_TEMPLATE_LIST_TEST_CASE(NAME, TAGS, TYPES)
 #    define TEMPLATE_TEST_CASE(NAME, TAGS, ...)        SNITCH_TEMPLATE_TEST_CASE(NAME, TAGS, __VA_ARGS__)
+#    define CONSTEXPR_TEST_CASE(NAME, ...)             SNITCH_CONSTEXPR_TEST_CASE(NAME, __VA_ARGS__)
 
 #    define TEST_CASE_METHOD(FIXTURE, NAME, ...)                       SNITCH_TEST_CASE_METHOD(FIXTURE, NAME, __VA_ARGS__)
 #    define TEMPLATE_LIST_TEST_CASE_METHOD(FIXTURE, NAME, TAGS, TYPES) SNITCH_TEMPLATE_LIST_TEST_CASE_METHOD(FIXTURE, NAME, TAGS, TYPES)
@@ -1656,11 +3153,14 @@ bool operator==(const M& m, const T& value) noexcept {
 #    define CHECK(EXP)                 SNITCH_CHECK(EXP)
 #    define REQUIRE_FALSE(EXP)         SNITCH_REQUIRE_FALSE(EXP)
 #    define CHECK_FALSE(EXP)           SNITCH_CHECK_FALSE(EXP)
+#    define STATIC_REQUIRE(EXP)        SNITCH_STATIC_REQUIRE(EXP)
+#    define STATIC_CHECK(EXP)          SNITCH_STATIC_CHECK(EXP)
+#    define CONSTEXPR_CHECK(EXP)       SNITCH_CONSTEXPR_CHECK(EXP)
 #    define FAIL(MESSAGE)              SNITCH_FAIL(MESSAGE)
 #    define FAIL_CHECK(MESSAGE)        SNITCH_FAIL_CHECK(MESSAGE)
 #    define SKIP(MESSAGE)              SNITCH_SKIP(MESSAGE)
-#    define REQUIRE_THAT(EXP, MATCHER) SNITCH_REQUIRE(EXP, MATCHER)
-#    define CHECK_THAT(EXP, MATCHER)   SNITCH_CHECK(EXP, MATCHER)
+#    define REQUIRE_THAT(EXP, MATCHER) SNITCH_REQUIRE_THAT(EXP, MATCHER)
+#    define CHECK_THAT(EXP, MATCHER)   SNITCH_CHECK_THAT(EXP, MATCHER)
 #endif
 // clang-format on
 
@@ -1671,13 +3171,14 @@ bool operator==(const M& m, const T& value) noexcept {
             auto& SNITCH_CURRENT_TEST = snitch::impl::get_current_test();                          \
             try {                                                                                  \
                 ++SNITCH_CURRENT_TEST.asserts;                                                     \
+                SNITCH_ASSERTION_SITE();                                                           \
                 EXPRESSION;                                                                        \
                 SNITCH_CURRENT_TEST.reg.report_failure(                                            \
                     SNITCH_CURRENT_TEST, {__FILE__, __LINE__},                                     \
                     #EXCEPTION " expected but no exception thrown");                               \
                 SNITCH_TESTING_ABORT;                                                              \
             } catch (const EXCEPTION&) {                                                           \
-                /* success */                                                                      \
+                SNITCH_ASSERTION_PASSED(SNITCH_CURRENT_TEST);                                      \
             } catch (...) {                                                                        \
                 try {                                                                              \
                     throw;                                                                         \
@@ -1700,12 +3201,13 @@ bool operator==(const M& m, const T& value) noexcept {
             auto& SNITCH_CURRENT_TEST = snitch::impl::get_current_test();                          \
             try {                                                                                  \
                 ++SNITCH_CURRENT_TEST.asserts;                                                     \
+                SNITCH_ASSERTION_SITE();                                                           \
                 EXPRESSION;                                                                        \
                 SNITCH_CURRENT_TEST.reg.report_failure(                                            \
                     SNITCH_CURRENT_TEST, {__FILE__, __LINE__},                                     \
                     #EXCEPTION " expected but no exception thrown");                               \
             } catch (const EXCEPTION&) {                                                           \
-                /* success */                                                                      \
+                SNITCH_ASSERTION_PASSED(SNITCH_CURRENT_TEST);                                      \
             } catch (...) {                                                                        \
                 try {                                                                              \
                     throw;                                                                         \
@@ -1727,6 +3229,7 @@ bool operator==(const M& m, const T& value) noexcept {
             auto& SNITCH_CURRENT_TEST = snitch::impl::get_current_test();                          \
             try {                                                                                  \
                 ++SNITCH_CURRENT_TEST.asserts;                                                     \
+                SNITCH_ASSERTION_SITE();                                                           \
                 EXPRESSION;                                                                        \
                 SNITCH_CURRENT_TEST.reg.report_failure(                                            \
                     SNITCH_CURRENT_TEST, {__FILE__, __LINE__},                                     \
@@ -1739,6 +3242,8 @@ bool operator==(const M& m, const T& value) noexcept {
                         "could not match caught " #EXCEPTION " with expected content: ",           \
                         (MATCHER).describe_match(e, snitch::matchers::match_status::failed));      \
                     SNITCH_TESTING_ABORT;                                                          \
+                } else {                                                                           \
+                    SNITCH_ASSERTION_PASSED(SNITCH_CURRENT_TEST);                                  \
                 }                                                                                  \
             } catch (...) {                                                                        \
                 try {                                                                              \
@@ -1762,6 +3267,7 @@ bool operator==(const M& m, const T& value) noexcept {
             auto& SNITCH_CURRENT_TEST = snitch::impl::get_current_test();                          \
             try {                                                                                  \
                 ++SNITCH_CURRENT_TEST.asserts;                                                     \
+                SNITCH_ASSERTION_SITE();                                                           \
                 EXPRESSION;                                                                        \
                 SNITCH_CURRENT_TEST.reg.report_failure(                                            \
                     SNITCH_CURRENT_TEST, {__FILE__, __LINE__},                                     \
@@ -1772,6 +3278,8 @@ bool operator==(const M& m, const T& value) noexcept {
                         SNITCH_CURRENT_TEST, {__FILE__, __LINE__},                                 \
                         "could not match caught " #EXCEPTION " with expected content: ",           \
                         (MATCHER).describe_match(e, snitch::matchers::match_status::failed));      \
+                } else {                                                                           \
+                    SNITCH_ASSERTION_PASSED(SNITCH_CURRENT_TEST);                                  \
                 }                                                                                  \
             } catch (...) {                                                                        \
                 try {                                                                              \
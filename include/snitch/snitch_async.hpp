@@ -0,0 +1,202 @@
+#ifndef SNITCH_ASYNC_HPP
+#define SNITCH_ASYNC_HPP
+
+#include "snitch/snitch.hpp"
+
+#include <array> // for the event ring
+#include <atomic> // for std::atomic
+#include <thread> // for the reporter thread
+
+namespace snitch::async {
+// What to do when an event is reported while the ring is full.
+enum class overflow_policy {
+    // Wait until the reporter thread has made room for the event.
+    block,
+    // Drop the event, and increment the drop counter. Events marking the start or the end of a
+    // test case or test run are never dropped.
+    drop
+};
+
+// Reporter adapter which forwards the events to another reporter, running on a separate thread.
+// Events are copied into a fixed-size, lock-free ring; the reporter thread processes them in the
+// order in which they were reported. Reporting the end of a test run waits until all the events
+// have been processed. The output of the registry's selected reporter handling the event, where
+// registry::print() writes, is passed along with the event.
+//
+// The ring is stored inline, and each slot holds a snitch::event_copy, so this object is large;
+// declare it static, global, or as a local variable in main().
+template<std::size_t RingSize>
+class reporter {
+    static_assert(
+        RingSize > 0u && (RingSize & (RingSize - 1u)) == 0u, "ring size must be a power of two");
+
+    // What the reporter thread does with a slot.
+    enum class command { report, flush, stop };
+
+    struct slot {
+        std::atomic<std::size_t> sequence = 0u;
+        const registry*          reg      = nullptr;
+        std::FILE*               output   = nullptr;
+        command                  action   = command::report;
+        event_copy               event;
+    };
+
+    std::array<slot, RingSize> ring;
+
+    alignas(64) std::atomic<std::size_t> write_pos = 0u;
+    alignas(64) std::atomic<std::size_t> read_pos  = 0u;
+    alignas(64) std::atomic<std::size_t> dropped   = 0u;
+
+    registry::report_function downstream;
+    overflow_policy           policy = overflow_policy::block;
+    std::thread               worker;
+
+    static bool is_droppable(const event::data& e) noexcept {
+        return std::holds_alternative<event::assertion_failed>(e) ||
+               std::holds_alternative<event::assertion_passed>(e) ||
+               std::holds_alternative<event::assertion_failures_suppressed>(e) ||
+               std::holds_alternative<event::test_case_skipped>(e);
+    }
+
+    static bool is_boundary(const event::data& e) noexcept {
+        return std::holds_alternative<event::test_case_ended>(e) ||
+               std::holds_alternative<event::test_run_ended>(e);
+    }
+
+    slot* claim(std::size_t& pos, bool may_drop) noexcept {
+        pos = write_pos.load(std::memory_order_relaxed);
+        while (true) {
+            slot&             s    = ring[pos % RingSize];
+            const std::size_t seq  = s.sequence.load(std::memory_order_acquire);
+            const auto        diff = static_cast<std::ptrdiff_t>(seq - pos);
+
+            if (diff == 0) {
+                if (write_pos.compare_exchange_weak(pos, pos + 1u, std::memory_order_relaxed)) {
+                    return &s;
+                }
+            } else if (diff < 0) {
+                // The ring is full.
+                if (may_drop) {
+                    dropped.fetch_add(1u, std::memory_order_relaxed);
+                    return nullptr;
+                }
+
+                s.sequence.wait(seq, std::memory_order_acquire);
+                pos = write_pos.load(std::memory_order_relaxed);
+            } else {
+                // Another thread claimed this slot first.
+                pos = write_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void publish(slot& s, std::size_t pos) noexcept {
+        s.sequence.store(pos + 1u, std::memory_order_release);
+        s.sequence.notify_all();
+    }
+
+    void run() noexcept {
+        std::size_t pos = 0u;
+        while (true) {
+            slot&             s   = ring[pos % RingSize];
+            const std::size_t seq = s.sequence.load(std::memory_order_acquire);
+            if (seq != pos + 1u) {
+                // Nothing to process; make sure the reporter output is not held back while idle.
+                impl::stdout_flush();
+                s.sequence.wait(seq, std::memory_order_acquire);
+                continue;
+            }
+
+            const command action = s.action;
+            bool          flush  = action != command::report;
+            if (action == command::report) {
+                impl::set_current_output(s.output);
+                downstream(*s.reg, s.event.get());
+                impl::set_current_output(nullptr);
+                flush = is_boundary(s.event.get());
+            }
+
+            // What the reporter printed is buffered on this thread; it must be written before
+            // flush() or the end of a test run returns.
+            if (flush) {
+                impl::stdout_flush();
+            }
+
+            s.sequence.store(pos + RingSize, std::memory_order_release);
+            s.sequence.notify_all();
+
+            ++pos;
+            read_pos.store(pos, std::memory_order_release);
+            read_pos.notify_all();
+
+            if (action == command::stop) {
+                return;
+            }
+        }
+    }
+
+public:
+    explicit reporter(
+        const registry::report_function& report,
+        overflow_policy                  overflow = overflow_policy::block) :
+        downstream(report), policy(overflow) {
+        for (std::size_t i = 0; i < RingSize; ++i) {
+            ring[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        worker = std::thread([this]() { run(); });
+    }
+
+    reporter(const reporter&)            = delete;
+    reporter& operator=(const reporter&) = delete;
+
+    ~reporter() noexcept {
+        std::size_t pos = 0u;
+        slot*       s   = claim(pos, false);
+        s->action       = command::stop;
+        publish(*s, pos);
+
+        worker.join();
+    }
+
+    void report(const registry& r, const event::data& e) noexcept {
+        std::size_t pos = 0u;
+        slot*       s   = claim(pos, policy == overflow_policy::drop && is_droppable(e));
+        if (s == nullptr) {
+            return;
+        }
+
+        s->reg    = &r;
+        s->output = impl::get_current_output();
+        s->action = command::report;
+        s->event.assign(e);
+        publish(*s, pos);
+
+        if (std::holds_alternative<event::test_run_ended>(e)) {
+            flush();
+        }
+    }
+
+    // Wait until all the events reported so far have been processed, and what the reporter
+    // printed has been written to the standard output.
+    void flush() noexcept {
+        std::size_t pos = 0u;
+        slot*       s   = claim(pos, false);
+        s->action       = command::flush;
+        publish(*s, pos);
+
+        std::size_t done = read_pos.load(std::memory_order_acquire);
+        while (done <= pos) {
+            read_pos.wait(done, std::memory_order_acquire);
+            done = read_pos.load(std::memory_order_acquire);
+        }
+    }
+
+    // Number of events dropped so far because the ring was full.
+    std::size_t dropped_count() const noexcept {
+        return dropped.load(std::memory_order_relaxed);
+    }
+};
+} // namespace snitch::async
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef SNITCH_BATCH_HPP
+#define SNITCH_BATCH_HPP
+
+#include "snitch/snitch.hpp"
+
+#include <utility> // for std::as_const
+
+namespace snitch::batch {
+// Events of a batch, in the order they were reported; use get() to access each event.
+using events = small_vector_span<const event_copy>;
+
+using report_function = small_function<void(const registry&, events) noexcept>;
+
+// Reporter adapter which collects events, and forwards them to a batch reporter in a single call.
+// A batch is sent at the end of each test case, at the end of the test run, and whenever
+// `BatchSize` events have been collected. The events, and the strings they refer to, remain
+// valid until the batch reporter returns; this lets it format and write a whole batch at once.
+//
+// Each event is stored in a snitch::event_copy, so this object is large; declare it static,
+// global, or as a local variable in main().
+template<std::size_t BatchSize>
+class reporter {
+    static_assert(BatchSize > 0u, "batch size must be at least one");
+
+    small_vector<event_copy, BatchSize> batch;
+    const registry*                     reg = nullptr;
+    report_function                     downstream;
+
+public:
+    explicit reporter(const report_function& report) noexcept : downstream(report) {}
+
+    reporter(const reporter&)            = delete;
+    reporter& operator=(const reporter&) = delete;
+
+    void report(const registry& r, const event::data& e) noexcept {
+        if (reg != &r) {
+            flush();
+            reg = &r;
+        }
+
+        batch.grow(1u);
+        batch.back().assign(e);
+
+        if (batch.available() == 0u || std::holds_alternative<event::test_case_ended>(e) ||
+            std::holds_alternative<event::test_run_ended>(e)) {
+            flush();
+        }
+    }
+
+    // Sends the events collected so far, if any.
+    void flush() noexcept {
+        if (batch.empty()) {
+            return;
+        }
+
+        downstream(*reg, std::as_const(batch).span());
+        batch.clear();
+    }
+};
+} // namespace snitch::batch
+
+#endif
@@ -0,0 +1,749 @@
+#ifndef SNITCH_BINARY_HPP
+#define SNITCH_BINARY_HPP
+
+#include "snitch/snitch.hpp"
+
+#include <algorithm> // for std::min
+#include <array> // for record buffers and the string table
+#include <bit> // for std::bit_cast
+#include <cstdint> // for std::uint32_t, std::uint64_t
+#include <cstdio> // for std::FILE
+
+// Compact binary event stream.
+// ----------------------------
+//
+// The stream starts with the 8-byte header below, followed by records. Each record is made of
+// a one-byte type, the length of its payload, and the payload. All integers are encoded as
+// unsigned LEB128 varints, and floats as four little-endian bytes.
+//
+// Test names, tags, types, and file names are written once in a string record, and referred to
+// by their index in the string table afterwards. A string reference is either that index (which
+// starts at one), or zero followed by the length and bytes of the string.
+//
+// Payload of each record type, in order (an ID is the name, tags, and type string references;
+// a location is the file string reference and the line; flags and states are single bytes):
+//  - string: string index, string bytes.
+//  - test_run_started: name, test count.
+//  - test_run_ended: success, run count, fail count, skip count, assertion count, duration, name.
+//  - test_case_started: ID.
+//  - test_case_ended: state, assertion count, duration, ID, captured output.
+//  - section_started: ID, section count, name and description of each section.
+//  - section_ended: duration, ID, section count, name and description of each section.
+//  - assertion_failed: flags (1: expected, 2: allowed), ID, location, section count, capture
+//    count, name and description of each section, each capture, message.
+//  - assertion_passed: ID, location, section count, capture count, sections, captures.
+//  - assertion_failures_suppressed: count, ID, location.
+//  - test_case_skipped: ID, location, section count, capture count, sections, captures, message.
+//
+// At most `max_nested_sections` sections and `max_captures` captures are written in a record;
+// strings which do not fit in a record are truncated.
+//
+// Any change to these layouts requires a new format version. Readers must skip records of
+// unknown type, and reject streams of another version.
+
+namespace snitch::binary {
+// Stream header; the last character is the format version.
+constexpr std::string_view stream_header = "SNITCHB\x01";
+
+// Capacity of the string table. Once full, strings are written in full in each record.
+constexpr std::size_t max_strings      = 1024;
+constexpr std::size_t max_string_bytes = 64 * 1024;
+
+// Maximum length of the payload of an event record; longer strings are truncated.
+constexpr std::size_t max_record_length = max_event_copy_length;
+
+enum class record_type : unsigned char {
+    string = 0,
+    test_run_started,
+    test_run_ended,
+    test_case_started,
+    test_case_ended,
+    assertion_failed,
+    assertion_failures_suppressed,
+    test_case_skipped,
+    section_started,
+    section_ended,
+    assertion_passed
+};
+
+// Reporter writing the events to a binary stream. The file (or pipe) is not owned, and must
+// remain open for as long as the writer is used. If a write fails, an error is printed through
+// the registry, and nothing more is written. This object is large; declare it static, global, or
+// as a local variable in main().
+class writer {
+    struct table_entry {
+        std::uint64_t hash   = 0;
+        std::size_t   offset = 0;
+        std::size_t   size   = 0;
+        std::size_t   id     = 0;
+    };
+
+    std::FILE* file = nullptr;
+
+    small_string<max_string_bytes>               strings;
+    std::array<table_entry, 2 * max_strings>     table       = {};
+    std::size_t                                  table_size  = 0;
+    std::array<unsigned char, max_record_length> record      = {};
+    std::size_t                                  record_size = 0;
+    bool                                         write_error = false;
+    bool                                         reported    = false;
+
+    static std::uint64_t hash(std::string_view s) noexcept {
+        // FNV-1a
+        std::uint64_t h = 14695981039346656037u;
+        for (char c : s) {
+            h = (h ^ static_cast<unsigned char>(c)) * 1099511628211u;
+        }
+        return h;
+    }
+
+    static std::size_t encode_varint(unsigned char* out, std::size_t value) noexcept {
+        std::size_t size = 0;
+        do {
+            unsigned char byte = static_cast<unsigned char>(value & 0x7fu);
+            value >>= 7u;
+            if (value != 0) {
+                byte |= 0x80u;
+            }
+            out[size++] = byte;
+        } while (value != 0);
+        return size;
+    }
+
+    void write(const void* data, std::size_t size) noexcept {
+        // After a failed write, the stream cannot be decoded past that point; stop there.
+        if (!write_error && std::fwrite(data, 1u, size, file) != size) {
+            write_error = true;
+        }
+    }
+
+    void write_record(record_type type, const unsigned char* payload, std::size_t size) noexcept {
+        std::array<unsigned char, 16> header;
+        header[0]                     = static_cast<unsigned char>(type);
+        const std::size_t header_size = 1u + encode_varint(header.data() + 1u, size);
+
+        write(header.data(), header_size);
+        write(payload, size);
+    }
+
+    std::size_t intern(std::string_view s) noexcept {
+        if (s.empty()) {
+            return 0;
+        }
+
+        const std::uint64_t h    = hash(s);
+        const std::size_t   mask = table.size() - 1u;
+        std::size_t         slot = static_cast<std::size_t>(h) & mask;
+        while (table[slot].id != 0) {
+            const table_entry& e = table[slot];
+            if (e.hash == h && strings.str().substr(e.offset, e.size) == s) {
+                return e.id;
+            }
+            slot = (slot + 1u) & mask;
+        }
+
+        if (table_size == max_strings || s.size() > strings.available()) {
+            return 0;
+        }
+
+        const std::size_t offset = strings.size();
+        append_or_truncate(strings, s);
+        table[slot] = {h, offset, s.size(), ++table_size};
+
+        // The string record payload is the string ID, followed by the string bytes.
+        std::array<unsigned char, 16> id;
+        const std::size_t             id_size = encode_varint(id.data(), table_size);
+
+        std::array<unsigned char, 16> header;
+        header[0] = static_cast<unsigned char>(record_type::string);
+        const std::size_t header_size =
+            1u + encode_varint(header.data() + 1u, id_size + s.size());
+
+        write(header.data(), header_size);
+        write(id.data(), id_size);
+        write(s.data(), s.size());
+
+        return table_size;
+    }
+
+    void report_write_error(const registry& r) noexcept {
+        if (!reported) {
+            reported = true;
+            r.print("error: could not write the binary event stream; no more events are written\n");
+        }
+    }
+
+    void put_byte(unsigned char value) noexcept {
+        if (record_size < record.size()) {
+            record[record_size++] = value;
+        }
+    }
+
+    void put_varint(std::size_t value) noexcept {
+        std::array<unsigned char, 16> bytes;
+        const std::size_t             size = encode_varint(bytes.data(), value);
+        for (std::size_t i = 0; i < size; ++i) {
+            put_byte(bytes[i]);
+        }
+    }
+
+    void put_float(float value) noexcept {
+        const auto bits = std::bit_cast<std::uint32_t>(value);
+        for (std::size_t i = 0; i < 4u; ++i) {
+            put_byte(static_cast<unsigned char>((bits >> (8u * i)) & 0xffu));
+        }
+    }
+
+    void put_string(std::string_view s, bool interned = false) noexcept {
+        if (interned) {
+            if (const std::size_t id = intern(s); id != 0) {
+                put_varint(id);
+                return;
+            }
+        }
+
+        // Keep room for the fields that follow; truncate the string if it does not fit.
+        constexpr std::size_t reserved  = 128u;
+        const std::size_t     available = record.size() - record_size;
+        const std::size_t     length =
+            available > reserved ? std::min(s.size(), available - reserved) : 0u;
+
+        put_varint(0u);
+        put_varint(length);
+        for (std::size_t i = 0; i < length; ++i) {
+            put_byte(static_cast<unsigned char>(s[i]));
+        }
+    }
+
+    void put_id(const test_id& id) noexcept {
+        put_string(id.name, true);
+        put_string(id.tags, true);
+        put_string(id.type, true);
+    }
+
+    void put_location(const assertion_location& location) noexcept {
+        put_string(location.file, true);
+        put_varint(location.line);
+    }
+
+    // Only the sections and captures the reader can keep are written, so the strings fit in the
+    // room put_string() keeps for the fields that follow them.
+    void put_section_list(const section_info& sections, std::size_t count) noexcept {
+        for (std::size_t i = 0; i < count; ++i) {
+            put_string(sections[i].name);
+            put_string(sections[i].description);
+        }
+    }
+
+    void put_sections(const section_info& sections) noexcept {
+        const std::size_t count = std::min(sections.size(), max_nested_sections);
+        put_varint(count);
+        put_section_list(sections, count);
+    }
+
+    void put_sections_and_captures(
+        const section_info& sections, const capture_info& captures) noexcept {
+        const std::size_t section_count = std::min(sections.size(), max_nested_sections);
+        const std::size_t capture_count = std::min(captures.size(), max_captures);
+        put_varint(section_count);
+        put_varint(capture_count);
+        put_section_list(sections, section_count);
+        for (std::size_t i = 0; i < capture_count; ++i) {
+            put_string(captures[i]);
+        }
+    }
+
+public:
+    explicit writer(std::FILE* f) noexcept : file(f) {
+        write(stream_header.data(), stream_header.size());
+    }
+
+    writer(const writer&)            = delete;
+    writer& operator=(const writer&) = delete;
+
+    void report(const registry& r, const event::data& event) noexcept {
+        if (write_error) {
+            report_write_error(r);
+            return;
+        }
+
+        record_size = 0;
+
+        const record_type type = std::visit(
+            snitch::overload{
+                [&](const event::test_run_started& e) {
+                    put_string(e.name);
+                    put_varint(e.test_count);
+                    return record_type::test_run_started;
+                },
+                [&](const event::test_run_ended& e) {
+                    put_byte(e.success ? 1u : 0u);
+                    put_varint(e.run_count);
+                    put_varint(e.fail_count);
+                    put_varint(e.skip_count);
+                    put_varint(e.assertion_count);
+#if SNITCH_WITH_TIMINGS
+                    put_float(e.duration);
+#else
+                    put_float(0.0f);
+#endif
+                    put_string(e.name);
+                    return record_type::test_run_ended;
+                },
+                [&](const event::test_case_started& e) {
+                    put_id(e.id);
+                    return record_type::test_case_started;
+                },
+                [&](const event::test_case_ended& e) {
+                    put_byte(static_cast<unsigned char>(e.state));
+                    put_varint(e.assertion_count);
+#if SNITCH_WITH_TIMINGS
+                    put_float(e.duration);
+#else
+                    put_float(0.0f);
+#endif
+                    put_id(e.id);
+                    put_string(e.output);
+                    return record_type::test_case_ended;
+                },
+                [&](const event::section_started& e) {
+                    put_id(e.id);
+                    put_sections(e.sections);
+                    return record_type::section_started;
+                },
+                [&](const event::section_ended& e) {
+#if SNITCH_WITH_TIMINGS
+                    put_float(e.duration);
+#else
+                    put_float(0.0f);
+#endif
+                    put_id(e.id);
+                    put_sections(e.sections);
+                    return record_type::section_ended;
+                },
+                [&](const event::assertion_failed& e) {
+                    put_byte((e.expected ? 1u : 0u) | (e.allowed ? 2u : 0u));
+                    put_id(e.id);
+                    put_location(e.location);
+                    put_sections_and_captures(e.sections, e.captures);
+                    put_string(e.message);
+                    return record_type::assertion_failed;
+                },
+                [&](const event::assertion_passed& e) {
+                    put_id(e.id);
+                    put_location(e.location);
+                    put_sections_and_captures(e.sections, e.captures);
+                    return record_type::assertion_passed;
+                },
+                [&](const event::assertion_failures_suppressed& e) {
+                    put_varint(e.count);
+                    put_id(e.id);
+                    put_location(e.location);
+                    return record_type::assertion_failures_suppressed;
+                },
+                [&](const event::test_case_skipped& e) {
+                    put_id(e.id);
+                    put_location(e.location);
+                    put_sections_and_captures(e.sections, e.captures);
+                    put_string(e.message);
+                    return record_type::test_case_skipped;
+                }},
+            event);
+
+        write_record(type, record.data(), record_size);
+
+        if (std::holds_alternative<event::test_run_ended>(event) && std::fflush(file) != 0) {
+            write_error = true;
+        }
+
+        if (write_error) {
+            report_write_error(r);
+        }
+    }
+
+    // True if a write failed; the stream is then incomplete.
+    bool failed() const noexcept {
+        return write_error;
+    }
+};
+
+// Decoder for a binary event stream, replaying the events into any reporter. This object is
+// large; declare it static, global, or as a local variable in main().
+class reader {
+    std::FILE* file = nullptr;
+
+    small_string<max_string_bytes>               strings;
+    small_vector<std::string_view, max_strings>  table;
+    std::array<unsigned char, max_record_length> record      = {};
+    std::size_t                                  record_size = 0;
+    std::size_t                                  position    = 0;
+    bool                                         error       = false;
+
+    std::optional<std::size_t> read_file_varint() noexcept {
+        std::size_t value = 0;
+        for (std::size_t shift = 0; shift < 64u; shift += 7u) {
+            const int c = std::fgetc(file);
+            if (c == EOF) {
+                return {};
+            }
+
+            value |= static_cast<std::size_t>(c & 0x7f) << shift;
+            if ((c & 0x80) == 0) {
+                return value;
+            }
+        }
+
+        return {};
+    }
+
+    bool skip(std::size_t size) noexcept {
+        std::array<unsigned char, 256> discard;
+        while (size > 0) {
+            const std::size_t chunk = std::min(size, discard.size());
+            if (std::fread(discard.data(), 1u, chunk, file) != chunk) {
+                return false;
+            }
+            size -= chunk;
+        }
+
+        return true;
+    }
+
+    bool read_string_record(std::size_t size) noexcept {
+        std::size_t id         = 0;
+        std::size_t id_size    = 0;
+        bool        terminated = false;
+        for (std::size_t shift = 0; shift < 64u && id_size < size; shift += 7u) {
+            const int c = std::fgetc(file);
+            if (c == EOF) {
+                return false;
+            }
+
+            ++id_size;
+            id |= static_cast<std::size_t>(c & 0x7f) << shift;
+            if ((c & 0x80) == 0) {
+                terminated = true;
+                break;
+            }
+        }
+
+        const std::size_t length = size - id_size;
+        if (!terminated || id != table.size() + 1u || table.available() == 0u ||
+            length > strings.available()) {
+            return false;
+        }
+
+        const std::size_t offset = strings.size();
+        strings.grow(length);
+        if (std::fread(strings.data() + offset, 1u, length, file) != length) {
+            return false;
+        }
+
+        table.push_back(strings.str().substr(offset, length));
+        return true;
+    }
+
+    unsigned char get_byte() noexcept {
+        if (position >= record_size) {
+            error = true;
+            return 0u;
+        }
+
+        return record[position++];
+    }
+
+    std::size_t get_varint() noexcept {
+        std::size_t value = 0;
+        for (std::size_t shift = 0; shift < 64u; shift += 7u) {
+            const unsigned char c = get_byte();
+            value |= static_cast<std::size_t>(c & 0x7fu) << shift;
+            if ((c & 0x80u) == 0) {
+                return value;
+            }
+        }
+
+        error = true;
+        return 0u;
+    }
+
+    float get_float() noexcept {
+        std::uint32_t bits = 0;
+        for (std::size_t i = 0; i < 4u; ++i) {
+            bits |= static_cast<std::uint32_t>(get_byte()) << (8u * i);
+        }
+
+        return std::bit_cast<float>(bits);
+    }
+
+    std::string_view get_string() noexcept {
+        const std::size_t id = get_varint();
+        if (id != 0) {
+            if (id > table.size()) {
+                error = true;
+                return {};
+            }
+
+            return table[id - 1u];
+        }
+
+        const std::size_t length = get_varint();
+        if (error || length > record_size - position) {
+            error = true;
+            return {};
+        }
+
+        const std::string_view s{reinterpret_cast<const char*>(record.data()) + position, length};
+        position += length;
+        return s;
+    }
+
+    test_id get_id() noexcept {
+        test_id id;
+        id.name = get_string();
+        id.tags = get_string();
+        id.type = get_string();
+        return id;
+    }
+
+    assertion_location get_location() noexcept {
+        assertion_location location;
+        location.file = get_string();
+        location.line = get_varint();
+        return location;
+    }
+
+    // Sections and captures which do not fit are read, but not reported, like in event_copy.
+    void get_sections(
+        small_vector<section_id, max_nested_sections>& sections,
+        std::size_t                                    section_count) noexcept {
+        for (std::size_t i = 0; i < section_count && !error; ++i) {
+            section_id s;
+            s.name        = get_string();
+            s.description = get_string();
+            if (sections.available() != 0) {
+                sections.push_back(s);
+            }
+        }
+    }
+
+    void get_sections(small_vector<section_id, max_nested_sections>& sections) noexcept {
+        get_sections(sections, get_varint());
+    }
+
+    void get_sections_and_captures(
+        small_vector<section_id, max_nested_sections>& sections,
+        small_vector<std::string_view, max_captures>&  captures) noexcept {
+
+        const std::size_t section_count = get_varint();
+        const std::size_t capture_count = get_varint();
+
+        get_sections(sections, section_count);
+        for (std::size_t i = 0; i < capture_count && !error; ++i) {
+            const std::string_view c = get_string();
+            if (captures.available() != 0) {
+                captures.push_back(c);
+            }
+        }
+    }
+
+    bool report_record(
+        record_type type, const registry& r, const registry::report_function& report) noexcept {
+        small_vector<section_id, max_nested_sections> sections;
+        small_vector<std::string_view, max_captures>  captures;
+
+        position = 0;
+        error    = false;
+
+        switch (type) {
+        case record_type::test_run_started: {
+            const std::string_view        name  = get_string();
+            const std::size_t             count = get_varint();
+            const event::test_run_started e{.name = name, .test_count = count};
+            if (!error) {
+                report(r, e);
+            }
+            break;
+        }
+        case record_type::test_run_ended: {
+            event::test_run_ended e;
+            e.success         = get_byte() != 0u;
+            e.run_count       = get_varint();
+            e.fail_count      = get_varint();
+            e.skip_count      = get_varint();
+            e.assertion_count = get_varint();
+#if SNITCH_WITH_TIMINGS
+            e.duration = get_float();
+#else
+            get_float();
+#endif
+            e.name = get_string();
+            if (!error) {
+                report(r, e);
+            }
+            break;
+        }
+        case record_type::test_case_started: {
+            const test_id id = get_id();
+            if (!error) {
+                report(r, event::test_case_started{id});
+            }
+            break;
+        }
+        case record_type::test_case_ended: {
+            const unsigned char    state           = get_byte();
+            const std::size_t      assertion_count = get_varint();
+            const float            duration        = get_float();
+            const test_id          id              = get_id();
+            const std::string_view output          = get_string();
+            static_cast<void>(duration);
+            if (state > static_cast<unsigned char>(test_case_state::skipped)) {
+                error = true;
+            }
+            if (!error) {
+#if SNITCH_WITH_TIMINGS
+                report(
+                    r, event::test_case_ended{
+                           .id              = id,
+                           .state           = static_cast<test_case_state>(state),
+                           .assertion_count = assertion_count,
+                           .duration        = duration,
+                           .output          = output});
+#else
+                report(
+                    r, event::test_case_ended{
+                           .id              = id,
+                           .state           = static_cast<test_case_state>(state),
+                           .assertion_count = assertion_count,
+                           .output          = output});
+#endif
+            }
+            break;
+        }
+        case record_type::section_started: {
+            const test_id id = get_id();
+            get_sections(sections);
+            if (!error) {
+                report(r, event::section_started{id, sections});
+            }
+            break;
+        }
+        case record_type::section_ended: {
+            const float   duration = get_float();
+            const test_id id       = get_id();
+            get_sections(sections);
+            static_cast<void>(duration);
+            if (!error) {
+#if SNITCH_WITH_TIMINGS
+                report(
+                    r, event::section_ended{.id = id, .sections = sections, .duration = duration});
+#else
+                report(r, event::section_ended{.id = id, .sections = sections});
+#endif
+            }
+            break;
+        }
+        case record_type::assertion_failed: {
+            const unsigned char      flags    = get_byte();
+            const test_id            id       = get_id();
+            const assertion_location location = get_location();
+            get_sections_and_captures(sections, captures);
+            const std::string_view message = get_string();
+            if (!error) {
+                report(
+                    r, event::assertion_failed{
+                           id, sections, captures, location, message, (flags & 1u) != 0u,
+                           (flags & 2u) != 0u});
+            }
+            break;
+        }
+        case record_type::assertion_passed: {
+            const test_id            id       = get_id();
+            const assertion_location location = get_location();
+            get_sections_and_captures(sections, captures);
+            if (!error) {
+                report(r, event::assertion_passed{id, sections, captures, location});
+            }
+            break;
+        }
+        case record_type::assertion_failures_suppressed: {
+            const std::size_t        count    = get_varint();
+            const test_id            id       = get_id();
+            const assertion_location location = get_location();
+            if (!error) {
+                report(r, event::assertion_failures_suppressed{id, location, count});
+            }
+            break;
+        }
+        case record_type::test_case_skipped: {
+            const test_id            id       = get_id();
+            const assertion_location location = get_location();
+            get_sections_and_captures(sections, captures);
+            const std::string_view message = get_string();
+            if (!error) {
+                report(r, event::test_case_skipped{id, sections, captures, location, message});
+            }
+            break;
+        }
+        default: {
+            // Unknown record; already skipped.
+            break;
+        }
+        }
+
+        return !error;
+    }
+
+public:
+    explicit reader(std::FILE* f) noexcept : file(f) {}
+
+    reader(const reader&)            = delete;
+    reader& operator=(const reader&) = delete;
+
+    // Read the whole stream, and forward each event to the reporter, in order. Returns false if
+    // the stream is not a valid binary event stream, or ends in the middle of a record.
+    bool replay(const registry& r, const registry::report_function& report) noexcept {
+        std::array<char, stream_header.size()> header;
+        if (std::fread(header.data(), 1u, header.size(), file) != header.size() ||
+            std::string_view{header.data(), header.size()} != stream_header) {
+            return false;
+        }
+
+        while (true) {
+            const int type = std::fgetc(file);
+            if (type == EOF) {
+                return true;
+            }
+
+            const std::optional<std::size_t> size = read_file_varint();
+            if (!size) {
+                return false;
+            }
+
+            if (type == static_cast<int>(record_type::string)) {
+                if (!read_string_record(*size)) {
+                    return false;
+                }
+                continue;
+            }
+
+            if (type > static_cast<int>(record_type::assertion_passed)) {
+                if (!skip(*size)) {
+                    return false;
+                }
+                continue;
+            }
+
+            if (*size > record.size() || std::fread(record.data(), 1u, *size, file) != *size) {
+                return false;
+            }
+
+            record_size = *size;
+            if (!report_record(static_cast<record_type>(type), r, report)) {
+                return false;
+            }
+        }
+    }
+};
+} // namespace snitch::binary
+
+#endif
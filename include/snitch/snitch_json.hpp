@@ -0,0 +1,287 @@
+#ifndef SNITCH_JSON_HPP
+#define SNITCH_JSON_HPP
+
+#include "snitch/snitch.hpp"
+
+#include <algorithm> // for std::min
+#include <array> // for escape tables
+#include <cstdio> // for std::FILE
+
+namespace snitch::json {
+// The "\u00XX" escape sequence of each control character, one after the other.
+inline constexpr auto unicode_escapes = []() {
+    constexpr std::string_view hex_digits = "0123456789abcdef";
+
+    std::array<char, 6 * impl::control_characters.size()> sequences = {};
+    for (std::size_t i = 0; i < impl::control_characters.size(); ++i) {
+        sequences[6 * i + 0] = '\\';
+        sequences[6 * i + 1] = 'u';
+        sequences[6 * i + 2] = '0';
+        sequences[6 * i + 3] = '0';
+        sequences[6 * i + 4] = hex_digits[i >> 4u];
+        sequences[6 * i + 5] = hex_digits[i & 0xfu];
+    }
+    return sequences;
+}();
+
+// JSON special characters, and their escape sequences. Control characters without a short escape
+// sequence are written as "\u00XX".
+inline constexpr auto escapes = []() {
+    std::array<string_replacement, 5 + impl::control_characters.size()> table = {{
+        {"\"", "\\\""},
+        {"\\", "\\\\"},
+        {"\n", "\\n"},
+        {"\r", "\\r"},
+        {"\t", "\\t"},
+    }};
+
+    // Patterns are tried in order, so the short escape sequences above take precedence.
+    for (std::size_t i = 0; i < impl::control_characters.size(); ++i) {
+        table[5 + i] = {{&impl::control_characters[i], 1u}, {&unicode_escapes[6 * i], 6u}};
+    }
+    return table;
+}();
+
+// Length of the longest escape sequence in the table above.
+constexpr std::size_t max_escape_length = 6u;
+
+// Writes the string in quotes, with the JSON special characters escaped. The string is escaped in
+// chunks, small enough to always fit in the buffer once escaped.
+inline void write_string(std::FILE* output, std::string_view s) noexcept {
+    constexpr std::size_t chunk_size = 256u;
+
+    small_string<chunk_size * max_escape_length + 1u> buffer;
+    buffer.push_back('"');
+    for (; !s.empty(); s.remove_prefix(std::min(s.size(), chunk_size))) {
+        static_cast<void>(append_replaced(buffer, s.substr(0, chunk_size), escapes));
+        std::fwrite(buffer.data(), 1u, buffer.size(), output);
+        buffer.clear();
+    }
+
+    buffer.push_back('"');
+    std::fwrite(buffer.data(), 1u, buffer.size(), output);
+}
+
+// Reporter writing one JSON object per event and per line (JSON Lines), to a file, a pipe, or
+// the standard output. The file is not owned, and must remain open for as long as the reporter
+// is used. The output is flushed at the end of each test case, and at the end of the test run.
+class reporter {
+    std::FILE* output = nullptr;
+
+    void write(std::string_view s) noexcept {
+        if (!s.empty()) {
+            std::fwrite(s.data(), 1u, s.size(), output);
+        }
+    }
+
+    template<typename T>
+    void write_number(T value) noexcept {
+        small_string<32> string;
+        append_or_truncate(string, value);
+        write(string);
+    }
+
+    void write_bool(bool value) noexcept {
+        write(value ? "true" : "false");
+    }
+
+    void write_string(std::string_view s) noexcept {
+        json::write_string(output, s);
+    }
+
+    void write_key(std::string_view key) noexcept {
+        write(",\"");
+        write(key);
+        write("\":");
+    }
+
+    void begin(std::string_view event) noexcept {
+        write("{\"event\":\"");
+        write(event);
+        write("\"");
+    }
+
+    void end() noexcept {
+        write("}\n");
+    }
+
+    void write_id(const test_id& id) noexcept {
+        write_key("id");
+        write("{\"name\":");
+        write_string(id.name);
+        write(",\"tags\":");
+        write_string(id.tags);
+        write(",\"type\":");
+        write_string(id.type);
+        write("}");
+    }
+
+    void write_location(const assertion_location& location) noexcept {
+        write_key("location");
+        write("{\"file\":");
+        write_string(location.file);
+        write(",\"line\":");
+        write_number(location.line);
+        write("}");
+    }
+
+    void write_sections(const section_info& sections) noexcept {
+        write_key("sections");
+        write("[");
+        bool first = true;
+        for (const auto& s : sections) {
+            write(first ? "{\"name\":" : ",{\"name\":");
+            write_string(s.name);
+            write(",\"description\":");
+            write_string(s.description);
+            write("}");
+            first = false;
+        }
+        write("]");
+    }
+
+    void write_sections_and_captures(
+        const section_info& sections, const capture_info& captures) noexcept {
+        write_sections(sections);
+
+        write_key("captures");
+        write("[");
+        bool first = true;
+        for (const auto& c : captures) {
+            if (!first) {
+                write(",");
+            }
+            write_string(c);
+            first = false;
+        }
+        write("]");
+    }
+
+    static std::string_view to_string(test_case_state state) noexcept {
+        switch (state) {
+        case test_case_state::success: return "success";
+        case test_case_state::failed: return "failed";
+        case test_case_state::skipped: return "skipped";
+        default: return "unknown";
+        }
+    }
+
+public:
+    explicit reporter(std::FILE* out = stdout) noexcept : output(out) {}
+
+    void report(const registry&, const event::data& event) noexcept {
+        std::visit(
+            snitch::overload{
+                [&](const event::test_run_started& e) {
+                    begin("test_run_started");
+                    write_key("name");
+                    write_string(e.name);
+                    write_key("test_count");
+                    write_number(e.test_count);
+                    end();
+                },
+                [&](const event::test_run_ended& e) {
+                    begin("test_run_ended");
+                    write_key("name");
+                    write_string(e.name);
+                    write_key("success");
+                    write_bool(e.success);
+                    write_key("run_count");
+                    write_number(e.run_count);
+                    write_key("fail_count");
+                    write_number(e.fail_count);
+                    write_key("skip_count");
+                    write_number(e.skip_count);
+                    write_key("assertion_count");
+                    write_number(e.assertion_count);
+#if SNITCH_WITH_TIMINGS
+                    write_key("duration");
+                    write_number(e.duration);
+#endif
+                    end();
+                    std::fflush(output);
+                },
+                [&](const event::test_case_started& e) {
+                    begin("test_case_started");
+                    write_id(e.id);
+                    end();
+                },
+                [&](const event::test_case_ended& e) {
+                    begin("test_case_ended");
+                    write_id(e.id);
+                    write_key("state");
+                    write_string(to_string(e.state));
+                    write_key("assertion_count");
+                    write_number(e.assertion_count);
+#if SNITCH_WITH_TIMINGS
+                    write_key("duration");
+                    write_number(e.duration);
+#endif
+                    write_key("output");
+                    write_string(e.output);
+                    end();
+                    std::fflush(output);
+                },
+                [&](const event::section_started& e) {
+                    begin("section_started");
+                    write_id(e.id);
+                    write_sections(e.sections);
+                    end();
+                },
+                [&](const event::section_ended& e) {
+                    begin("section_ended");
+                    write_id(e.id);
+                    write_sections(e.sections);
+#if SNITCH_WITH_TIMINGS
+                    write_key("duration");
+                    write_number(e.duration);
+#endif
+                    end();
+                },
+                [&](const event::assertion_failed& e) {
+                    begin("assertion_failed");
+                    write_id(e.id);
+                    write_location(e.location);
+                    write_sections_and_captures(e.sections, e.captures);
+                    write_key("message");
+                    write_string(e.message);
+                    write_key("expected");
+                    write_bool(e.expected);
+                    write_key("allowed");
+                    write_bool(e.allowed);
+                    end();
+                },
+                [&](const event::assertion_passed& e) {
+                    begin("assertion_passed");
+                    write_id(e.id);
+                    write_location(e.location);
+                    write_sections_and_captures(e.sections, e.captures);
+                    end();
+                },
+                [&](const event::assertion_failures_suppressed& e) {
+                    begin("assertion_failures_suppressed");
+                    write_id(e.id);
+                    write_location(e.location);
+                    write_key("count");
+                    write_number(e.count);
+                    end();
+                },
+                [&](const event::test_case_skipped& e) {
+                    begin("test_case_skipped");
+                    write_id(e.id);
+                    write_location(e.location);
+                    write_sections_and_captures(e.sections, e.captures);
+                    write_key("message");
+                    write_string(e.message);
+                    end();
+                }},
+            event);
+    }
+};
+
+// Makes the reporter available on the command line, as "--reporter json".
+inline const std::string_view registered_reporter =
+    snitch::tests.add_reporter("json", &snitch::impl::make_reporter<reporter>);
+} // namespace snitch::json
+
+#endif
@@ -0,0 +1,247 @@
+#ifndef SNITCH_JUNIT_HPP
+#define SNITCH_JUNIT_HPP
+
+#include "snitch/snitch.hpp"
+
+#include <algorithm> // for std::min
+#include <array> // for copy buffers and escape tables
+#include <cstdio> // for std::FILE, std::tmpfile
+
+namespace snitch::junit {
+// XML special characters, and the entities they are replaced with. Other control characters are
+// not allowed in XML 1.0, and are replaced with '?'.
+inline constexpr auto escapes = []() {
+    std::array<string_replacement, 8 + impl::control_characters.size()> table = {{
+        {"&", "&amp;"},
+        {"<", "&lt;"},
+        {">", "&gt;"},
+        {"\"", "&quot;"},
+        {"'", "&apos;"},
+        {"\n", "&#10;"},
+        {"\r", "&#13;"},
+        {"\t", "&#9;"},
+    }};
+
+    // Patterns are tried in order, so the entities above take precedence.
+    for (std::size_t i = 0; i < impl::control_characters.size(); ++i) {
+        table[8 + i] = {{&impl::control_characters[i], 1u}, "?"};
+    }
+    return table;
+}();
+
+// Length of the longest entity in the table above.
+constexpr std::size_t max_entity_length = 6u;
+
+// Reporter writing a JUnit XML report to a file (or pipe). The file is not owned, and must
+// remain open for as long as the reporter is used.
+//
+// Test cases are streamed to a temporary file as they finish, and the final report (which needs
+// the totals in its header) is assembled when the test run ends; memory usage does not depend
+// on the number of test cases or failures.
+class reporter {
+    std::FILE* output  = nullptr;
+    std::FILE* body    = nullptr;
+    std::FILE* current = nullptr;
+
+    small_string<max_test_name_length> suite_name;
+
+    static void write(std::FILE* f, std::string_view s) noexcept {
+        if (f != nullptr && !s.empty()) {
+            std::fwrite(s.data(), 1u, s.size(), f);
+        }
+    }
+
+    // Writes the string with the XML special characters replaced by entities. The string is
+    // escaped in chunks, small enough to always fit in the buffer once escaped.
+    static void write_escaped(std::FILE* f, std::string_view s) noexcept {
+        constexpr std::size_t chunk_size = 256u;
+
+        small_string<chunk_size * max_entity_length> buffer;
+        for (; !s.empty(); s.remove_prefix(std::min(s.size(), chunk_size))) {
+            buffer.clear();
+            static_cast<void>(append_replaced(buffer, s.substr(0, chunk_size), escapes));
+            write(f, buffer);
+        }
+    }
+
+    template<typename T>
+    static void write_number(std::FILE* f, T value) noexcept {
+        small_string<32> string;
+        append_or_truncate(string, value);
+        write(f, string);
+    }
+
+    static void copy(std::FILE* from, std::size_t size, std::FILE* to) noexcept {
+        if (from == nullptr) {
+            return;
+        }
+
+        std::array<char, 4096> buffer;
+        std::rewind(from);
+        while (size > 0) {
+            const std::size_t chunk = std::min(size, buffer.size());
+            const std::size_t read  = std::fread(buffer.data(), 1u, chunk, from);
+            if (read == 0) {
+                break;
+            }
+
+            write(to, {buffer.data(), read});
+            size -= read;
+        }
+    }
+
+    static std::size_t position(std::FILE* f) noexcept {
+        if (f == nullptr) {
+            return 0;
+        }
+
+        const long pos = std::ftell(f);
+        return pos > 0 ? static_cast<std::size_t>(pos) : 0u;
+    }
+
+    void write_location(
+        const assertion_location& location,
+        const section_info&       sections,
+        const capture_info&       captures) noexcept {
+
+        write_escaped(current, location.file);
+        write(current, ":");
+        write_number(current, location.line);
+        for (const auto& s : sections) {
+            write(current, "\nin section: ");
+            write_escaped(current, s.name);
+        }
+        for (const auto& c : captures) {
+            write(current, "\nwith ");
+            write_escaped(current, c);
+        }
+    }
+
+    void start_test_case() noexcept {
+        if (current != nullptr) {
+            std::rewind(current);
+        }
+    }
+
+    void end_test_case(const event::test_case_ended& e) noexcept {
+        const std::size_t current_size = position(current);
+
+        write(body, "    <testcase classname=\"");
+        write_escaped(body, suite_name);
+        write(body, "\" name=\"");
+        write_escaped(body, e.id.name);
+        if (!e.id.type.empty()) {
+            write(body, " [");
+            write_escaped(body, e.id.type);
+            write(body, "]");
+        }
+#if SNITCH_WITH_TIMINGS
+        write(body, "\" time=\"");
+        write_number(body, e.duration);
+#endif
+
+        if (current_size == 0 && e.output.empty()) {
+            write(body, "\"/>\n");
+        } else {
+            write(body, "\">\n");
+            copy(current, current_size, body);
+            if (!e.output.empty()) {
+                write(body, "      <system-out>");
+                write_escaped(body, e.output);
+                write(body, "</system-out>\n");
+            }
+            write(body, "    </testcase>\n");
+        }
+    }
+
+public:
+    explicit reporter(std::FILE* out) noexcept :
+        output(out), body(std::tmpfile()), current(std::tmpfile()) {}
+
+    reporter(const reporter&)            = delete;
+    reporter& operator=(const reporter&) = delete;
+
+    ~reporter() noexcept {
+        if (body != nullptr) {
+            std::fclose(body);
+        }
+        if (current != nullptr) {
+            std::fclose(current);
+        }
+    }
+
+    void report(const registry&, const event::data& event) noexcept {
+        std::visit(
+            snitch::overload{
+                [&](const event::test_run_started& e) {
+                    suite_name.clear();
+                    append_or_truncate(suite_name, e.name);
+                    if (body != nullptr) {
+                        std::rewind(body);
+                    }
+                },
+                [&](const event::test_run_ended& e) {
+                    const std::size_t body_size = position(body);
+
+                    write(output, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<testsuites>\n");
+                    write(output, "  <testsuite name=\"");
+                    write_escaped(output, e.name);
+                    write(output, "\" tests=\"");
+                    write_number(output, e.run_count);
+                    write(output, "\" failures=\"");
+                    write_number(output, e.fail_count);
+                    write(output, "\" skipped=\"");
+                    write_number(output, e.skip_count);
+                    write(output, "\" errors=\"0\"");
+#if SNITCH_WITH_TIMINGS
+                    write(output, " time=\"");
+                    write_number(output, e.duration);
+                    write(output, "\"");
+#endif
+                    write(output, ">\n");
+                    copy(body, body_size, output);
+                    write(output, "  </testsuite>\n</testsuites>\n");
+                    std::fflush(output);
+                },
+                [&](const event::test_case_started&) { start_test_case(); },
+                [&](const event::test_case_ended& e) { end_test_case(e); },
+                [&](const event::section_started&) {},
+                [&](const event::section_ended&) {},
+                [&](const event::assertion_failed& e) {
+                    if (e.expected || e.allowed) {
+                        return;
+                    }
+
+                    write(current, "      <failure message=\"");
+                    write_escaped(current, e.message);
+                    write(current, "\">");
+                    write_location(e.location, e.sections, e.captures);
+                    write(current, "</failure>\n");
+                },
+                [&](const event::assertion_passed&) {},
+                [&](const event::assertion_failures_suppressed& e) {
+                    write(current, "      <failure message=\"... and ");
+                    write_number(current, e.count);
+                    write(current, " more failures\">");
+                    write_escaped(current, e.location.file);
+                    write(current, ":");
+                    write_number(current, e.location.line);
+                    write(current, "</failure>\n");
+                },
+                [&](const event::test_case_skipped& e) {
+                    write(current, "      <skipped message=\"");
+                    write_escaped(current, e.message);
+                    write(current, "\">");
+                    write_location(e.location, e.sections, e.captures);
+                    write(current, "</skipped>\n");
+                }},
+            event);
+    }
+};
+
+// Makes the reporter available on the command line, as "--reporter junit".
+inline const std::string_view registered_reporter =
+    snitch::tests.add_reporter("junit", &snitch::impl::make_reporter<reporter>);
+} // namespace snitch::junit
+
+#endif
@@ -0,0 +1,310 @@
+#ifndef SNITCH_METRICS_HPP
+#define SNITCH_METRICS_HPP
+
+#include "snitch/snitch.hpp"
+
+#include <array>  // for the bucket bounds
+#include <cstdio> // for std::FILE
+
+namespace snitch::metrics {
+// Upper bounds of the test case duration histograms, in seconds.
+inline constexpr std::array<float, 7> duration_buckets = {0.001f, 0.01f, 0.1f, 0.5f,
+                                                         1.0f,   10.0f, 60.0f};
+
+// Maximum number of slow test cases listed individually; when more are found, the fastest of
+// them are dropped.
+constexpr std::size_t max_slow_tests = 32;
+
+// Maximum total length of the tags with a duration histogram; tags which do not fit are not
+// listed.
+constexpr std::size_t max_tags_length = 8192;
+
+// Duration histogram, with cumulative bucket counts as in the output format.
+struct histogram {
+    std::array<std::size_t, duration_buckets.size()> buckets = {};
+    std::size_t                                       count   = 0;
+    double                                            sum     = 0.0;
+
+    void add(float duration) noexcept {
+        for (std::size_t i = 0; i < duration_buckets.size(); ++i) {
+            if (duration <= duration_buckets[i]) {
+                ++buckets[i];
+            }
+        }
+
+        ++count;
+        sum += static_cast<double>(duration);
+    }
+};
+
+// Reporter writing statistics of the test run in the OpenMetrics text format, at the end of the
+// run. This can be written to the directory of the node-exporter "textfile" collector, or pushed
+// to a Prometheus Pushgateway. The file is not owned, and must remain open for as long as the
+// reporter is used.
+//
+// The test case counts are written as gauges, since each file describes a single run. With
+// SNITCH_WITH_TIMINGS, this also writes the run duration, a histogram of test case durations for
+// all test cases and for each tag, and the duration of each test case slower than the threshold.
+class reporter {
+    // The strings of an event do not outlive the call to report(), so tags and test names are
+    // copied: tags are stored one after the other in `tags`.
+    struct tag_histogram {
+        std::size_t offset = 0;
+        std::size_t length = 0;
+        histogram   durations;
+    };
+
+    struct slow_test {
+        small_string<max_test_name_length> name;
+        float                              duration = 0.0f;
+    };
+
+    std::FILE*                                   output         = nullptr;
+    float                                        slow_threshold = 1.0f;
+    std::array<std::size_t, 3>                   state_counts   = {};
+    histogram                                    durations      = {};
+    small_vector<tag_histogram, max_unique_tags> tag_durations  = {};
+    small_string<max_tags_length>                tags           = {};
+    small_vector<slow_test, max_slow_tests>      slow_tests     = {};
+
+    void write(std::string_view s) noexcept {
+        if (!s.empty()) {
+            std::fwrite(s.data(), 1u, s.size(), output);
+        }
+    }
+
+    template<typename T>
+    void write_number(T value) noexcept {
+        small_string<32> string;
+        append_or_truncate(string, value);
+        write(string);
+    }
+
+    void
+    write_header(std::string_view name, std::string_view type, std::string_view help) noexcept {
+        write("# TYPE ");
+        write(name);
+        write(" ");
+        write(type);
+        write("\n# HELP ");
+        write(name);
+        write(" ");
+        write(help);
+        write("\n");
+    }
+
+    // Writes a label value, escaping backslashes, double quotes, and line breaks.
+    void write_label_value(std::string_view value) noexcept {
+        write("\"");
+        std::size_t start = 0;
+        for (std::size_t i = 0; i < value.size(); ++i) {
+            const char c = value[i];
+            if (c != '\\' && c != '"' && c != '\n') {
+                continue;
+            }
+
+            write(value.substr(start, i - start));
+            write(c == '\\' ? "\\\\" : c == '"' ? "\\\"" : "\\n");
+            start = i + 1u;
+        }
+
+        write(value.substr(start));
+        write("\"");
+    }
+
+    // Writes one sample; the label is omitted if its name is empty.
+    template<typename T>
+    void write_sample(
+        std::string_view name,
+        std::string_view label,
+        std::string_view label_value,
+        std::string_view bound,
+        T                value) noexcept {
+        write(name);
+        if (!label.empty() || !bound.empty()) {
+            write("{");
+            if (!label.empty()) {
+                write(label);
+                write("=");
+                write_label_value(label_value);
+            }
+            if (!bound.empty()) {
+                write(label.empty() ? "le=\"" : ",le=\"");
+                write(bound);
+                write("\"");
+            }
+            write("}");
+        }
+        write(" ");
+        write_number(value);
+        write("\n");
+    }
+
+    void write_histogram(
+        std::string_view name,
+        std::string_view label,
+        std::string_view label_value,
+        const histogram& h) noexcept {
+        small_string<64> sample_name;
+        for (std::size_t i = 0; i < duration_buckets.size(); ++i) {
+            small_string<32> bound;
+            append_or_truncate(bound, duration_buckets[i]);
+            sample_name.clear();
+            append_or_truncate(sample_name, name, "_bucket");
+            write_sample(sample_name, label, label_value, bound, h.buckets[i]);
+        }
+
+        write_sample(sample_name, label, label_value, "+Inf", h.count);
+        sample_name.clear();
+        append_or_truncate(sample_name, name, "_sum");
+        write_sample(sample_name, label, label_value, {}, h.sum);
+        sample_name.clear();
+        append_or_truncate(sample_name, name, "_count");
+        write_sample(sample_name, label, label_value, {}, h.count);
+    }
+
+    std::string_view get_tag(const tag_histogram& t) const noexcept {
+        return tags.str().substr(t.offset, t.length);
+    }
+
+    void add_tag_duration(std::string_view tag, float duration) noexcept {
+        for (auto& t : tag_durations) {
+            if (get_tag(t) == tag) {
+                t.durations.add(duration);
+                return;
+            }
+        }
+
+        if (tag_durations.available() != 0u && tags.available() >= tag.size()) {
+            tag_durations.push_back({tags.size(), tag.size(), {}});
+            tags.append_range(tag);
+            tag_durations.back().durations.add(duration);
+        }
+    }
+
+    void add_slow_test(const test_id& id, float duration) noexcept {
+        small_string<max_test_name_length> name;
+        if (id.type.empty()) {
+            append_or_truncate(name, id.name);
+        } else {
+            append_or_truncate(name, id.name, " [", id.type, "]");
+        }
+
+        if (slow_tests.available() != 0u) {
+            slow_tests.push_back({name, duration});
+            return;
+        }
+
+        // Full: replace the fastest, if this one is slower.
+        slow_test* fastest = &slow_tests[0];
+        for (auto& t : slow_tests) {
+            if (t.duration < fastest->duration) {
+                fastest = &t;
+            }
+        }
+
+        if (duration > fastest->duration) {
+            *fastest = {name, duration};
+        }
+    }
+
+    void add_test_case(const event::test_case_ended& e) noexcept {
+        ++state_counts[static_cast<std::size_t>(e.state)];
+
+#if SNITCH_WITH_TIMINGS
+        durations.add(e.duration);
+
+        // Tags are listed as "[tag1][tag2]"; each duration is added once per tag.
+        std::string_view tags = e.id.tags;
+        while (!tags.empty()) {
+            const std::size_t open  = tags.find('[');
+            const std::size_t close = tags.find(']', open);
+            if (open == tags.npos || close == tags.npos) {
+                break;
+            }
+
+            add_tag_duration(tags.substr(open + 1u, close - open - 1u), e.duration);
+            tags.remove_prefix(close + 1u);
+        }
+
+        if (e.duration >= slow_threshold) {
+            add_slow_test(e.id, e.duration);
+        }
+#endif
+    }
+
+    void write_run(const event::test_run_ended& e) noexcept {
+        constexpr std::array<std::string_view, 3> states = {"success", "failed", "skipped"};
+
+        write_header("snitch_test_cases", "gauge", "Number of test cases run, by final state.");
+        for (std::size_t i = 0; i < states.size(); ++i) {
+            write_sample("snitch_test_cases", "state", states[i], {}, state_counts[i]);
+        }
+
+        write_header("snitch_assertions", "gauge", "Number of assertions checked.");
+        write_sample("snitch_assertions", {}, {}, {}, e.assertion_count);
+
+        write_header("snitch_success", "gauge", "Whether the test run succeeded.");
+        write_sample("snitch_success", {}, {}, {}, e.success ? 1u : 0u);
+
+#if SNITCH_WITH_TIMINGS
+        write_header("snitch_run_duration_seconds", "gauge", "Duration of the test run.");
+        write_sample("snitch_run_duration_seconds", {}, {}, {}, e.duration);
+
+        write_header(
+            "snitch_test_case_duration_seconds", "histogram", "Duration of the test cases.");
+        write_histogram("snitch_test_case_duration_seconds", {}, {}, durations);
+
+        write_header(
+            "snitch_tag_duration_seconds", "histogram",
+            "Duration of the test cases with each tag.");
+        for (const auto& t : tag_durations) {
+            write_histogram("snitch_tag_duration_seconds", "tag", get_tag(t), t.durations);
+        }
+
+        write_header(
+            "snitch_slow_test_case_duration_seconds", "gauge",
+            "Duration of the test cases slower than the threshold.");
+        for (const auto& t : slow_tests) {
+            write_sample("snitch_slow_test_case_duration_seconds", "name", t.name, {}, t.duration);
+        }
+#endif
+
+        write("# EOF\n");
+        std::fflush(output);
+    }
+
+public:
+    // Test cases taking at least `slow_threshold_seconds` are listed individually.
+    explicit reporter(std::FILE* out, float slow_threshold_seconds = 1.0f) noexcept :
+        output(out), slow_threshold(slow_threshold_seconds) {}
+
+    void report(const registry&, const event::data& event) noexcept {
+        std::visit(
+            snitch::overload{
+                [&](const event::test_run_started&) {
+                    state_counts = {};
+                    durations    = {};
+                    tag_durations.clear();
+                    tags.clear();
+                    slow_tests.clear();
+                },
+                [&](const event::test_run_ended& e) { write_run(e); },
+                [&](const event::test_case_started&) {},
+                [&](const event::test_case_ended& e) { add_test_case(e); },
+                [&](const event::section_started&) {},
+                [&](const event::section_ended&) {},
+                [&](const event::test_case_skipped&) {},
+                [&](const event::assertion_failed&) {},
+                [&](const event::assertion_passed&) {},
+                [&](const event::assertion_failures_suppressed&) {}},
+            event);
+    }
+};
+
+// Makes the reporter available on the command line, as "--reporter metrics".
+inline const std::string_view registered_reporter =
+    snitch::tests.add_reporter("metrics", &snitch::impl::make_reporter<reporter>);
+} // namespace snitch::metrics
+
+#endif
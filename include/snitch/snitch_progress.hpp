@@ -0,0 +1,256 @@
+#ifndef SNITCH_PROGRESS_HPP
+#define SNITCH_PROGRESS_HPP
+
+#include "snitch/snitch.hpp"
+#include "snitch/snitch_json.hpp"
+
+#include <atomic>             // for the counters
+#include <chrono>             // for the sampling interval
+#include <condition_variable> // for waking up the sampling thread
+#include <cstdio>             // for std::FILE, std::rename
+#include <mutex>              // for std::mutex
+#include <thread>             // for the sampling thread
+
+namespace snitch::progress {
+// Progress of a test run, at a given time.
+struct sample {
+    std::string_view name       = {};
+    bool             running    = false;
+    std::size_t      total      = 0;
+    std::size_t      done       = 0;
+    std::size_t      failed     = 0;
+    std::size_t      skipped    = 0;
+    std::size_t      assertions = 0;
+    // Time since the start of the run, and estimated time until the end, in seconds. The
+    // estimate is negative until the first test case has ended.
+    float elapsed = 0.0f;
+    float eta     = -1.0f;
+
+    float tests_per_second() const noexcept {
+        return elapsed > 0.0f ? static_cast<float>(done) / elapsed : 0.0f;
+    }
+
+    float assertions_per_second() const noexcept {
+        return elapsed > 0.0f ? static_cast<float>(assertions) / elapsed : 0.0f;
+    }
+};
+
+// Appends a number of seconds as "m:ss", or "h:mm:ss" for an hour or more.
+inline bool append_duration(small_string_span ss, float seconds) noexcept {
+    const std::size_t total   = static_cast<std::size_t>(seconds + 0.5f);
+    const std::size_t hours   = total / 3600u;
+    const std::size_t minutes = (total / 60u) % 60u;
+    const std::size_t secs    = total % 60u;
+
+    bool fits = hours == 0u ? append(ss, minutes, ":")
+                            : append(ss, hours, minutes < 10u ? ":0" : ":", minutes, ":");
+    return fits && append(ss, secs < 10u ? "0" : "", secs);
+}
+
+// Formats the progress line shown on the terminal, for example:
+// "[ 37/121] 12.3 tests/s, 4567 assertions/s, ETA 0:12".
+inline small_string<max_message_length> make_line(const sample& s) noexcept {
+    small_string<max_message_length> line;
+
+    small_string<32> total;
+    append_or_truncate(total, s.total);
+    small_string<32> done;
+    append_or_truncate(done, s.done);
+
+    const std::size_t tests_rate = static_cast<std::size_t>(s.tests_per_second() * 10.0f + 0.5f);
+    append_or_truncate(line, "[");
+    for (std::size_t i = done.size(); i < total.size(); ++i) {
+        append_or_truncate(line, " ");
+    }
+    append_or_truncate(
+        line, done.str(), "/", total.str(), "] ", tests_rate / 10u, ".", tests_rate % 10u,
+        " tests/s, ", static_cast<std::size_t>(s.assertions_per_second() + 0.5f),
+        " assertions/s, ETA ");
+
+    if (s.eta >= 0.0f) {
+        append_duration(line, s.eta);
+    } else {
+        append_or_truncate(line, "?");
+    }
+
+    return line;
+}
+
+// Reporter showing the progress of the test run as a single line, refreshed at a fixed interval
+// on the given file (typically stderr, or stdout when the console reporter is quiet; when selected
+// without a file, impl::stdout_file(), so the line is not mixed with the captured output of a test
+// case). The same data can also be published to a status file, which is rewritten as a whole at
+// each interval, for local dashboards to poll. Set the file to null to only publish the status
+// file.
+//
+// Reporting an event only updates a few atomic counters; the line and the status file are
+// formatted and written by a separate thread, which samples the counters. This requires linking
+// to your platform's thread library.
+class reporter {
+    std::FILE*                       output = nullptr;
+    small_string<max_message_length> status_path;
+    small_string<max_message_length> temp_path;
+    std::chrono::milliseconds        interval;
+
+    std::atomic<std::size_t>        total      = 0;
+    std::atomic<std::size_t>        done       = 0;
+    std::atomic<std::size_t>        failed     = 0;
+    std::atomic<std::size_t>        skipped    = 0;
+    std::atomic<std::size_t>        assertions = 0;
+    std::atomic<impl::time_point_t> start_time = 0;
+    std::atomic<bool>               running    = false;
+    std::string_view                name       = {};
+
+    std::mutex              mutex;
+    std::condition_variable wake;
+    bool                    stop             = false;
+    std::size_t             last_line_length = 0;
+    std::thread             worker;
+
+    sample take_sample() const noexcept {
+        sample s{
+            .name       = name,
+            .running    = running.load(std::memory_order_acquire),
+            .total      = total.load(std::memory_order_relaxed),
+            .done       = done.load(std::memory_order_relaxed),
+            .failed     = failed.load(std::memory_order_relaxed),
+            .skipped    = skipped.load(std::memory_order_relaxed),
+            .assertions = assertions.load(std::memory_order_relaxed)};
+
+        s.elapsed = impl::get_duration_in_seconds(
+            start_time.load(std::memory_order_relaxed), impl::get_current_time());
+        if (s.done > 0u && s.done <= s.total) {
+            s.eta = s.elapsed / static_cast<float>(s.done) * static_cast<float>(s.total - s.done);
+        }
+
+        return s;
+    }
+
+    void write_line(const sample& s) noexcept {
+        const auto line = make_line(s);
+        std::fputc('\r', output);
+        std::fwrite(line.data(), 1u, line.size(), output);
+        for (std::size_t i = line.size(); i < last_line_length; ++i) {
+            std::fputc(' ', output);
+        }
+        if (!s.running) {
+            std::fputc('\n', output);
+        }
+        std::fflush(output);
+        last_line_length = s.running ? line.size() : 0u;
+    }
+
+    void write_status(const sample& s) noexcept {
+        std::FILE* file = std::fopen(temp_path.data(), "w");
+        if (file == nullptr) {
+            return;
+        }
+
+        std::fputs("{\"name\":", file);
+        json::write_string(file, s.name);
+        small_string<512> status;
+        append_or_truncate(
+            status, ",\"running\":", s.running ? "true" : "false", ",\"total\":", s.total,
+            ",\"done\":", s.done, ",\"failed\":", s.failed, ",\"skipped\":", s.skipped,
+            ",\"assertions\":", s.assertions, ",\"elapsed\":", s.elapsed,
+            ",\"tests_per_second\":", s.tests_per_second(),
+            ",\"assertions_per_second\":", s.assertions_per_second(), ",\"eta\":", s.eta, "}\n");
+        std::fwrite(status.data(), 1u, status.size(), file);
+        std::fclose(file);
+
+        // Replace the status file in one step, so it is never read half-written. On Windows,
+        // the old file must be removed first.
+        if (std::rename(temp_path.data(), status_path.data()) != 0) {
+            std::remove(status_path.data());
+            std::rename(temp_path.data(), status_path.data());
+        }
+    }
+
+    // Must be called with the mutex locked.
+    void publish() noexcept {
+        const sample s = take_sample();
+        if (output != nullptr) {
+            write_line(s);
+        }
+        if (!status_path.empty()) {
+            write_status(s);
+        }
+    }
+
+    void run() noexcept {
+        std::unique_lock lock(mutex);
+        while (!stop) {
+            wake.wait_for(lock, interval);
+            if (!stop && running.load(std::memory_order_acquire)) {
+                publish();
+            }
+        }
+    }
+
+public:
+    // The status file is not written if its path is empty. Paths which do not fit are ignored.
+    explicit reporter(
+        std::FILE*                out,
+        std::string_view          status_file = {},
+        std::chrono::milliseconds refresh     = std::chrono::milliseconds{500}) :
+        output(out), interval(refresh) {
+        // The paths must be null-terminated for fopen().
+        if (!status_file.empty() && append(status_path, status_file) &&
+            append(temp_path, status_file, ".tmp") && status_path.available() > 0u &&
+            temp_path.available() > 0u) {
+            status_path.push_back('\0');
+            temp_path.push_back('\0');
+        } else {
+            status_path.clear();
+        }
+
+        worker = std::thread([this]() { run(); });
+    }
+
+    reporter(const reporter&)            = delete;
+    reporter& operator=(const reporter&) = delete;
+
+    ~reporter() noexcept {
+        {
+            std::lock_guard lock(mutex);
+            stop = true;
+        }
+
+        wake.notify_one();
+        worker.join();
+    }
+
+    void report(const registry&, const event::data& event) noexcept {
+        if (const auto* e = std::get_if<event::test_case_ended>(&event)) {
+            done.fetch_add(1u, std::memory_order_relaxed);
+            assertions.fetch_add(e->assertion_count, std::memory_order_relaxed);
+            if (e->state == test_case_state::failed) {
+                failed.fetch_add(1u, std::memory_order_relaxed);
+            } else if (e->state == test_case_state::skipped) {
+                skipped.fetch_add(1u, std::memory_order_relaxed);
+            }
+        } else if (const auto* s = std::get_if<event::test_run_started>(&event)) {
+            std::lock_guard lock(mutex);
+            name = s->name;
+            total.store(s->test_count, std::memory_order_relaxed);
+            done.store(0u, std::memory_order_relaxed);
+            failed.store(0u, std::memory_order_relaxed);
+            skipped.store(0u, std::memory_order_relaxed);
+            assertions.store(0u, std::memory_order_relaxed);
+            start_time.store(impl::get_current_time(), std::memory_order_relaxed);
+            running.store(true, std::memory_order_release);
+        } else if (std::holds_alternative<event::test_run_ended>(event)) {
+            // Publish the final state right away, ending the line on the terminal.
+            std::lock_guard lock(mutex);
+            running.store(false, std::memory_order_release);
+            publish();
+        }
+    }
+};
+
+// Makes the reporter available on the command line, as "--reporter progress".
+inline const std::string_view registered_reporter =
+    snitch::tests.add_reporter("progress", &snitch::impl::make_reporter<reporter>);
+} // namespace snitch::progress
+
+#endif
@@ -3,33 +3,121 @@
 
 #include "snitch/snitch.hpp"
 
+#include <array> // for the escape table
+
 namespace snitch::teamcity {
 struct key_value {
     std::string_view key;
     std::string_view value;
 };
 
-void escape(small_string_span string) noexcept {
-    if (!replace_all(string, "|", "||") || !replace_all(string, "'", "|'") ||
-        !replace_all(string, "\n", "|n") || !replace_all(string, "\r", "|r") ||
-        !replace_all(string, "[", "|[") || !replace_all(string, "]", "|]")) {
-        truncate_end(string);
+// For each character, the character to write after '|' to escape it, or zero if the character
+// does not need escaping.
+inline constexpr std::array<char, 256> escape_table = []() {
+    std::array<char, 256> table = {};
+    table['|']                  = '|';
+    table['\'']                 = '\'';
+    table['\n']                 = 'n';
+    table['\r']                 = 'r';
+    table['[']                  = '[';
+    table[']']                  = ']';
+    return table;
+}();
+
+// Appends the escaped string in a single pass. Returns false if the string did not fit; an
+// escape sequence is never split.
+inline bool append_escaped(small_string_span ss, std::string_view string) noexcept {
+    std::size_t start = 0;
+    for (std::size_t i = 0; i < string.size(); ++i) {
+        const char escaped = escape_table[static_cast<unsigned char>(string[i])];
+        if (escaped == 0) {
+            continue;
+        }
+
+        if (!append(ss, string.substr(start, i - start)) || ss.available() < 2u) {
+            return false;
+        }
+
+        ss.push_back('|');
+        ss.push_back(escaped);
+        start = i + 1u;
+    }
+
+    return append(ss, string.substr(start));
+}
+
+// Escapes the string in place, in a single pass from the end. If the escaped string does not
+// fit, it is truncated and ends with "...".
+inline void escape(small_string_span string) noexcept {
+    std::size_t escaped_size = string.size();
+    for (char c : string) {
+        if (escape_table[static_cast<unsigned char>(c)] != 0) {
+            ++escaped_size;
+        }
+    }
+
+    if (escaped_size == string.size()) {
+        return;
+    }
+
+    // Only keep the characters whose escaped form fits, with room for the "...".
+    constexpr std::string_view dots     = "...";
+    const bool                 overflow = escaped_size > string.capacity();
+    const std::size_t          max_size =
+        overflow ? string.capacity() - std::min(string.capacity(), dots.size()) : escaped_size;
+
+    std::size_t kept_size = string.size();
+    while (escaped_size > max_size) {
+        --kept_size;
+        escaped_size -= escape_table[static_cast<unsigned char>(string[kept_size])] != 0 ? 2u : 1u;
+    }
+
+    string.resize(escaped_size);
+
+    std::size_t out = escaped_size;
+    for (std::size_t in = kept_size; in-- > 0;) {
+        const char c       = string[in];
+        const char escaped = escape_table[static_cast<unsigned char>(c)];
+        if (escaped != 0) {
+            string[--out] = escaped;
+            string[--out] = '|';
+        } else {
+            string[--out] = c;
+        }
+    }
+
+    if (overflow) {
+        append_or_truncate(string, dots);
     }
 }
 
-void send_message(
+// Sends a service message with a single print, escaping the values on the fly.
+inline void send_message(
     const registry& r, std::string_view message, std::initializer_list<key_value> args) noexcept {
     constexpr std::string_view teamcity_header = "##teamCity[";
     constexpr std::string_view teamcity_footer = "]\n";
 
-    r.print(teamcity_header, message);
+    small_string<2 * max_message_length> buffer;
+
+    bool fits = append(buffer, teamcity_header, message);
     for (const auto& arg : args) {
-        r.print(" ", arg.key, "='", arg.value, "'");
+        fits = fits && append(buffer, " ", arg.key, "='") && append_escaped(buffer, arg.value) &&
+               append(buffer, "'");
     }
-    r.print(teamcity_footer);
+
+    if (!fits) {
+        // Truncate the last value, keeping room for the closing quote and footer.
+        constexpr std::string_view truncated    = "...'";
+        constexpr std::size_t      closing_size = truncated.size() + teamcity_footer.size();
+        buffer.resize(std::min(buffer.size(), buffer.capacity() - closing_size));
+        append_or_truncate(buffer, truncated);
+    }
+
+    append_or_truncate(buffer, teamcity_footer);
+    r.print_message(buffer);
 }
 
-small_string<max_test_name_length> make_full_name(const test_id& id) noexcept {
+inline small_string<max_test_name_length> make_full_name(const test_id& id) noexcept {
     small_string<max_test_name_length> name;
     if (id.type.length() != 0) {
         append_or_truncate(name, id.name, "(\"", id.type, "\")");
@@ -37,11 +125,10 @@ small_string<max_test_name_length> make_full_name(const test_id& id) noexcept {
         append_or_truncate(name, id.name);
     }
 
-    escape(name);
     return name;
 }
 
-small_string<max_message_length> make_full_message(
+inline small_string<max_message_length> make_full_message(
     const snitch::assertion_location& location,
     const snitch::section_info&       sections,
     const snitch::capture_info&       captures,
@@ -57,38 +144,43 @@ small_string<max_message_length> make_full_message(
     }
 
     append_or_truncate(full_message, "  ", message);
-    escape(full_message);
     return full_message;
 }
 
-small_string<max_message_length> make_escaped(std::string_view string) noexcept {
-    small_string<max_message_length> escaped_string;
-    append_or_truncate(escaped_string, string);
-    escape(escaped_string);
-    return escaped_string;
+inline small_string<max_message_length> make_suppressed_message(
+    const snitch::assertion_location& location, std::size_t count) noexcept {
+    small_string<max_message_length> message;
+    append_or_truncate(
+        message, "... and ", count, " more failures at ", location.file, ":", location.line);
+    return message;
 }
 
 constexpr std::size_t max_duration_length = 32;
 
-small_string<max_duration_length> make_duration(float duration) noexcept {
+inline small_string<max_duration_length> make_duration(float duration) noexcept {
     small_string<max_duration_length> string;
     append_or_truncate(string, static_cast<std::size_t>(duration * 1e6));
     return string;
 }
 
-void report(const registry& r, const snitch::event::data& event) noexcept {
+inline void report(const registry& r, const snitch::event::data& event) noexcept {
     std::visit(
         snitch::overload{
             [&](const snitch::event::test_run_started& e) {
-                send_message(r, "testSuiteStarted", {{"name", make_escaped(e.name)}});
+                send_message(r, "testSuiteStarted", {{"name", e.name}});
             },
             [&](const snitch::event::test_run_ended& e) {
-                send_message(r, "testSuiteFinished", {{"name", make_escaped(e.name)}});
+                send_message(r, "testSuiteFinished", {{"name", e.name}});
             },
             [&](const snitch::event::test_case_started& e) {
                 send_message(r, "testStarted", {{"name", make_full_name(e.id)}});
             },
             [&](const snitch::event::test_case_ended& e) {
+                if (!e.output.empty()) {
+                    send_message(
+                        r, "testStdOut", {{"name", make_full_name(e.id)}, {"out", e.output}});
+                }
+
 #if SNITCH_WITH_TIMINGS
                 send_message(
                     r, "testFinished",
@@ -97,6 +189,8 @@ void report(const registry& r, const snitch::event::data& event) noexcept {
                 send_message(r, "testFinished", {{"name", make_full_name(e.id)}});
 #endif
             },
+            [&](const snitch::event::section_started&) {},
+            [&](const snitch::event::section_ended&) {},
             [&](const snitch::event::test_case_skipped& e) {
                 send_message(
                     r, "testIgnored",
@@ -110,9 +204,20 @@ void report(const registry& r, const snitch::event::data& event) noexcept {
                     {{"name", make_full_name(e.id)},
                      {"message",
                       make_full_message(e.location, e.sections, e.captures, e.message)}});
+            },
+            [&](const snitch::event::assertion_passed&) {},
+            [&](const snitch::event::assertion_failures_suppressed& e) {
+                send_message(
+                    r, "message",
+                    {{"text", make_suppressed_message(e.location, e.count)},
+                     {"status", "WARNING"}});
             }},
         event);
 }
+
+// Makes the reporter available on the command line, as "--reporter teamcity".
+inline const std::string_view registered_reporter = snitch::tests.add_reporter(
+    "teamcity", [](std::FILE*) noexcept -> registry::report_function { return &report; });
 } // namespace snitch::teamcity
 
 #endif
@@ -0,0 +1,264 @@
+#ifndef SNITCH_TRACE_HPP
+#define SNITCH_TRACE_HPP
+
+#include "snitch/snitch.hpp"
+#include "snitch/snitch_json.hpp"
+
+#include <cstdio> // for std::FILE
+#include <thread> // for std::this_thread::get_id
+
+namespace snitch::trace {
+// Maximum number of threads with their own track; events from further threads share the last.
+constexpr std::size_t max_threads = 64;
+
+// Reporter writing a timeline of the test run in the Chrome "trace event" JSON format, which can
+// be loaded in chrome://tracing, Perfetto, or Speedscope. Test runs, test cases, and sections are
+// written as spans, and failures and skips as instant events. The file is not owned, and must
+// remain open for as long as the reporter is used.
+//
+// Events are stamped with the time, and placed on the track of the thread they are reported
+// from; since tests run on the thread that calls the registry, this reporter must be called
+// directly, rather than from an async::reporter.
+class reporter {
+    std::FILE*                                 output      = nullptr;
+    impl::time_point_t                         start_time  = 0;
+    small_vector<std::thread::id, max_threads> threads     = {};
+    bool                                       first_event = true;
+
+    void write(std::string_view s) noexcept {
+        if (!s.empty()) {
+            std::fwrite(s.data(), 1u, s.size(), output);
+        }
+    }
+
+    template<typename T>
+    void write_number(T value) noexcept {
+        small_string<32> string;
+        append_or_truncate(string, value);
+        write(string);
+    }
+
+    // Writes the time elapsed since the start of the run, in microseconds, with nanosecond
+    // precision.
+    void write_timestamp(impl::time_point_t time) noexcept {
+        const impl::time_point_t elapsed  = time > start_time ? time - start_time : 0u;
+        const std::size_t        fraction = static_cast<std::size_t>(elapsed % 1000u);
+
+        write_number(static_cast<std::size_t>(elapsed / 1000u));
+        write(fraction < 10u ? ".00" : fraction < 100u ? ".0" : ".");
+        write_number(fraction);
+    }
+
+    void begin(
+        std::string_view   name,
+        std::string_view   category,
+        std::string_view   phase,
+        std::size_t        track,
+        impl::time_point_t time) noexcept {
+        write(first_event ? "[\n{\"name\":" : ",\n{\"name\":");
+        first_event = false;
+        json::write_string(output, name);
+        write(",\"cat\":\"");
+        write(category);
+        write("\",\"ph\":\"");
+        write(phase);
+        write("\",\"ts\":");
+        write_timestamp(time);
+        write(",\"pid\":1,\"tid\":");
+        write_number(track);
+        if (phase == "i") {
+            write(",\"s\":\"t\"");
+        }
+    }
+
+    void end() noexcept {
+        write("}");
+    }
+
+    void write_key(std::string_view key, bool first = false) noexcept {
+        write(first ? "{\"" : ",\"");
+        write(key);
+        write("\":");
+    }
+
+    void write_id_args(const test_id& id) noexcept {
+        write(",\"args\":");
+        write_key("tags", true);
+        json::write_string(output, id.tags);
+        write_key("type");
+        json::write_string(output, id.type);
+        write("}");
+    }
+
+    void write_location_args(
+        const assertion_location& location,
+        const section_info&       sections,
+        const capture_info&       captures,
+        std::string_view          message) noexcept {
+        write(",\"args\":");
+        write_key("file", true);
+        json::write_string(output, location.file);
+        write_key("line");
+        write_number(location.line);
+        write_key("message");
+        json::write_string(output, message);
+        if (!sections.empty()) {
+            write_key("section");
+            json::write_string(output, sections.back().name);
+        }
+        for (std::size_t i = 0; i < captures.size(); ++i) {
+            small_string<32> key;
+            append_or_truncate(key, "capture ", i + 1u);
+            write_key(key);
+            json::write_string(output, captures[i]);
+        }
+        write("}");
+    }
+
+    // Returns the track of the calling thread, and names the track when first seen.
+    std::size_t get_track(impl::time_point_t time) noexcept {
+        const std::thread::id id = std::this_thread::get_id();
+        for (std::size_t i = 0; i < threads.size(); ++i) {
+            if (threads[i] == id) {
+                return i + 1u;
+            }
+        }
+
+        if (threads.available() == 0u) {
+            return threads.size();
+        }
+
+        threads.push_back(id);
+        const std::size_t track = threads.size();
+
+        small_string<32> name;
+        append_or_truncate(name, "thread ", track);
+        begin("thread_name", "__metadata", "M", track, time);
+        write(",\"args\":");
+        write_key("name", true);
+        json::write_string(output, name);
+        write("}");
+        end();
+
+        return track;
+    }
+
+    static small_string<max_test_name_length> make_full_name(const test_id& id) noexcept {
+        small_string<max_test_name_length> name;
+        if (id.type.empty()) {
+            append_or_truncate(name, id.name);
+        } else {
+            append_or_truncate(name, id.name, " [", id.type, "]");
+        }
+
+        return name;
+    }
+
+    static std::string_view to_string(test_case_state state) noexcept {
+        switch (state) {
+        case test_case_state::success: return "success";
+        case test_case_state::failed: return "failed";
+        case test_case_state::skipped: return "skipped";
+        default: return "unknown";
+        }
+    }
+
+public:
+    explicit reporter(std::FILE* out) noexcept :
+        output(out), start_time(impl::get_current_time()) {}
+
+    void report(const registry&, const event::data& event) noexcept {
+        const impl::time_point_t time = impl::get_current_time();
+        if (std::holds_alternative<event::test_run_started>(event)) {
+            start_time = time;
+        }
+
+        const std::size_t track = get_track(time);
+
+        std::visit(
+            snitch::overload{
+                [&](const event::test_run_started& e) {
+                    begin(e.name, "run", "B", track, time);
+                    end();
+                },
+                [&](const event::test_run_ended& e) {
+                    begin(e.name, "run", "E", track, time);
+                    write(",\"args\":");
+                    write_key("success", true);
+                    write(e.success ? "true" : "false");
+                    write_key("run_count");
+                    write_number(e.run_count);
+                    write_key("fail_count");
+                    write_number(e.fail_count);
+                    write_key("skip_count");
+                    write_number(e.skip_count);
+                    write_key("assertion_count");
+                    write_number(e.assertion_count);
+                    write("}");
+                    end();
+
+                    // The array is left open until the run ends; trace viewers accept this, so
+                    // the timeline of a crashed run can still be loaded.
+                    write("\n]\n");
+                    std::fflush(output);
+                    first_event = true;
+                    threads.clear();
+                },
+                [&](const event::test_case_started& e) {
+                    begin(make_full_name(e.id), "test_case", "B", track, time);
+                    write_id_args(e.id);
+                    end();
+                },
+                [&](const event::test_case_ended& e) {
+                    begin(make_full_name(e.id), "test_case", "E", track, time);
+                    write(",\"args\":");
+                    write_key("state", true);
+                    json::write_string(output, to_string(e.state));
+                    write_key("assertion_count");
+                    write_number(e.assertion_count);
+                    write("}");
+                    end();
+                },
+                [&](const event::section_started& e) {
+                    begin(e.sections.back().name, "section", "B", track, time);
+                    end();
+                },
+                [&](const event::section_ended& e) {
+                    begin(e.sections.back().name, "section", "E", track, time);
+                    end();
+                },
+                [&](const event::assertion_failed& e) {
+                    begin(
+                        e.expected ? "expected failure" : e.allowed ? "allowed failure" : "failure",
+                        "assertion", "i", track, time);
+                    write_location_args(e.location, e.sections, e.captures, e.message);
+                    end();
+                },
+                [&](const event::assertion_passed&) {},
+                [&](const event::assertion_failures_suppressed& e) {
+                    begin("suppressed failures", "assertion", "i", track, time);
+                    write(",\"args\":");
+                    write_key("file", true);
+                    json::write_string(output, e.location.file);
+                    write_key("line");
+                    write_number(e.location.line);
+                    write_key("count");
+                    write_number(e.count);
+                    write("}");
+                    end();
+                },
+                [&](const event::test_case_skipped& e) {
+                    begin("skipped", "test_case", "i", track, time);
+                    write_location_args(e.location, e.sections, e.captures, e.message);
+                    end();
+                }},
+            event);
+    }
+};
+
+// Makes the reporter available on the command line, as "--reporter trace".
+inline const std::string_view registered_reporter =
+    snitch::tests.add_reporter("trace", &snitch::impl::make_reporter<reporter>);
+} // namespace snitch::trace
+
+#endif
@@ -1,14 +1,37 @@
 #include "snitch/snitch.hpp"
 
-#include <algorithm> // for std::sort
-#include <cstdio> // for std::printf, std::snprintf
-#include <cstring> // for std::memcpy
+#include <algorithm> // for std::sort, std::find_if
+#include <charconv> // for std::from_chars, std::to_chars
+#include <cstdint> // for std::uintptr_t
+#include <cstdio> // for std::fflush, std::fopen, std::snprintf
+#include <cstdlib> // for std::strtod, std::strtof
+#include <cstring> // for std::memcpy, std::memmove, std::memchr
+#include <limits> // for std::numeric_limits
 #include <optional> // for std::optional
 
-#if SNITCH_WITH_TIMINGS
-#    include <chrono> // for measuring test time
+#if defined(__unix__) || defined(__APPLE__)
+#    include <cerrno> // for errno, EINTR
+#    include <unistd.h> // for write, dup, dup2, STDOUT_FILENO
+#    define SNITCH_HAS_POSIX_WRITE 1
+#else
+#    define SNITCH_HAS_POSIX_WRITE 0
+#endif
+
+// Floating point std::to_chars. libc++ provides it from LLVM 14, but only defines
+// __cpp_lib_to_chars once std::from_chars is complete; on Apple platforms, it also depends on the
+// deployment target.
+#if defined(__cpp_lib_to_chars)
+#    define SNITCH_HAS_FLOAT_TO_CHARS 1
+#elif defined(_LIBCPP_AVAILABILITY_HAS_TO_CHARS_FLOATING_POINT)
+#    define SNITCH_HAS_FLOAT_TO_CHARS _LIBCPP_AVAILABILITY_HAS_TO_CHARS_FLOATING_POINT
+#elif defined(_LIBCPP_VERSION) && _LIBCPP_VERSION >= 14000 && !defined(__APPLE__)
+#    define SNITCH_HAS_FLOAT_TO_CHARS 1
+#else
+#    define SNITCH_HAS_FLOAT_TO_CHARS 0
 #endif
 
+#include <chrono> // for measuring test time
+
 // Testing framework implementation utilities.
 // -------------------------------------------
 
@@ -41,103 +64,332 @@ colored<T> make_colored(const T& t, bool with_color, color_t start) {
 }
 
 thread_local snitch::impl::test_state* thread_current_test = nullptr;
+
+thread_local std::FILE* thread_current_output = nullptr;
+
+#if SNITCH_HAS_POSIX_WRITE
+// Where the output of snitch goes. While the output of a test case is captured, this is a copy
+// of the original standard output.
+int stdout_fd = STDOUT_FILENO;
+#endif
+
+// Stream returned by snitch::impl::stdout_file(), if it was created.
+std::FILE* stdout_stream = nullptr;
+
+// Anything the tests have printed with stdio, then anything the reporters have written to
+// stdout_stream, must come out before the output of snitch.
+void flush_streams() noexcept {
+    std::fflush(stdout);
+    if (stdout_stream != nullptr && stdout_stream != stdout) {
+        std::fflush(stdout_stream);
+    }
+}
+
+void write_to_stdout(std::string_view message) noexcept {
+    flush_streams();
+
+#if SNITCH_HAS_POSIX_WRITE
+    while (!message.empty()) {
+        const auto written = ::write(stdout_fd, message.data(), message.size());
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return;
+        }
+
+        message.remove_prefix(static_cast<std::size_t>(written));
+    }
+#else
+    std::fwrite(message.data(), 1, message.size(), stdout);
+    std::fflush(stdout);
+#endif
+}
+
+// Coalesces the output sent to the standard output, so it can be written with a single
+// system call. Each thread has its own buffer; flushing a buffer writes all of its content
+// at once, so output from different threads is never interleaved within a flush.
+struct output_buffer {
+    snitch::small_string<snitch::max_buffered_output> data;
+
+    ~output_buffer() noexcept {
+        flush();
+    }
+
+    void print(std::string_view message) noexcept {
+        if (message.size() > data.available()) {
+            flush();
+
+            if (message.size() > data.available()) {
+                write_to_stdout(message);
+                return;
+            }
+        }
+
+        data.append_range(message);
+    }
+
+    void flush() noexcept {
+        if (data.empty()) {
+            flush_streams();
+            return;
+        }
+
+        write_to_stdout(data);
+        data.clear();
+    }
+};
+
+thread_local output_buffer thread_output;
+
+// Redirects the standard output and error of the process to a temporary file, which is reused
+// from one test case to the next. File descriptors are shared by all threads, so only one
+// capture can be active at a time.
+class output_capture {
+#if SNITCH_HAS_POSIX_WRITE
+    std::FILE* file      = nullptr;
+    int        saved_out = -1;
+    int        saved_err = -1;
+    bool       active    = false;
+
+    void restore() noexcept {
+        if (saved_out >= 0) {
+            ::dup2(saved_out, STDOUT_FILENO);
+            ::close(saved_out);
+        }
+        if (saved_err >= 0) {
+            ::dup2(saved_err, STDERR_FILENO);
+            ::close(saved_err);
+        }
+
+        saved_out = -1;
+        saved_err = -1;
+        stdout_fd = STDOUT_FILENO;
+    }
+
+public:
+    ~output_capture() noexcept {
+        if (file != nullptr) {
+            std::fclose(file);
+        }
+    }
+
+    bool start() noexcept {
+        if (active) {
+            return false;
+        }
+
+        if (file == nullptr) {
+            file = std::tmpfile();
+            if (file == nullptr) {
+                return false;
+            }
+        }
+
+        std::fflush(stdout);
+        std::fflush(stderr);
+
+        const int fd = ::fileno(file);
+        if (::ftruncate(fd, 0) != 0 || ::lseek(fd, 0, SEEK_SET) != 0) {
+            return false;
+        }
+
+        saved_out = ::dup(STDOUT_FILENO);
+        saved_err = ::dup(STDERR_FILENO);
+        if (saved_out < 0 || saved_err < 0 || ::dup2(fd, STDOUT_FILENO) < 0 ||
+            ::dup2(fd, STDERR_FILENO) < 0) {
+            restore();
+            return false;
+        }
+
+        stdout_fd = saved_out;
+        active    = true;
+        return true;
+    }
+
+    // Stops capturing. If `keep` is set, the end of the captured output is copied in `output`,
+    // starting with "..." if it did not fit.
+    void stop(snitch::small_string_span output, bool keep) noexcept {
+        std::fflush(stdout);
+        std::fflush(stderr);
+        restore();
+        active = false;
+
+        const int   fd   = ::fileno(file);
+        const off_t size = ::lseek(fd, 0, SEEK_END);
+        if (!keep || size <= 0 || output.capacity() == 0) {
+            return;
+        }
+
+        const std::size_t total = static_cast<std::size_t>(size);
+        const std::size_t kept  = std::min(total, output.capacity());
+        output.resize(kept);
+
+        std::size_t read = 0;
+        while (read < kept) {
+            const auto r = ::pread(
+                fd, output.data() + read, kept - read,
+                static_cast<off_t>(total - kept + read));
+            if (r < 0 && errno == EINTR) {
+                continue;
+            }
+            if (r <= 0) {
+                break;
+            }
+
+            read += static_cast<std::size_t>(r);
+        }
+
+        output.resize(read);
+        if (kept < total && read >= 3u) {
+            std::memcpy(output.data(), "...", 3u);
+        }
+    }
+#else
+public:
+    bool start() noexcept {
+        return false;
+    }
+
+    void stop(snitch::small_string_span, bool) noexcept {}
+#endif
+};
+
+output_capture process_output;
 } // namespace
 
 namespace {
 using snitch::small_string_span;
 
 template<typename T>
-constexpr const char* get_format_code() noexcept {
-    if constexpr (std::is_same_v<T, const void*>) {
-        return "%p";
-    } else if constexpr (std::is_same_v<T, std::size_t>) {
-        return "%zu";
-    } else if constexpr (std::is_same_v<T, std::ptrdiff_t>) {
-        return "%td";
-    } else if constexpr (std::is_same_v<T, float>) {
-        return "%f";
-    } else if constexpr (std::is_same_v<T, double>) {
-        return "%lf";
+bool append_to_chars(
+    small_string_span ss, T value, bool hexadecimal, std::size_t width, char fill) noexcept {
+    // Enough room for the shortest round-trip representation of a double, in any format.
+    std::array<char, 32> buffer;
+
+#if SNITCH_HAS_FLOAT_TO_CHARS
+    const auto result = hexadecimal
+                            ? std::to_chars(
+                                  buffer.data(), buffer.data() + buffer.size(), value,
+                                  std::chars_format::hex)
+                            : std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    if (result.ec != std::errc{}) {
+        return false;
+    }
+
+    std::string_view number(buffer.data(), static_cast<std::size_t>(result.ptr - buffer.data()));
+#else
+    // No std::to_chars for floating point values: use the smallest precision which reads back to
+    // the same value.
+    int size = 0;
+    if (hexadecimal) {
+        size = std::snprintf(buffer.data(), buffer.size(), "%a", static_cast<double>(value));
     } else {
-        static_assert(std::is_same_v<T, T>, "unsupported type");
+        for (int precision = std::numeric_limits<T>::digits10;
+             precision <= std::numeric_limits<T>::max_digits10; ++precision) {
+            size = std::snprintf(
+                buffer.data(), buffer.size(), "%.*g", precision, static_cast<double>(value));
+            if (size < 0 || static_cast<std::size_t>(size) >= buffer.size()) {
+                break;
+            }
+
+            const T read_back = std::is_same_v<T, float> ? std::strtof(buffer.data(), nullptr)
+                                                         : std::strtod(buffer.data(), nullptr);
+            if (read_back == value) {
+                break;
+            }
+        }
     }
-}
 
-template<typename T>
-bool append_fmt(small_string_span ss, T value) noexcept {
-    if (ss.available() <= 1) {
-        // snprintf will always print a null-terminating character,
-        // so abort early if only space for one or zero character, as
-        // this would clobber the original string.
+    if (size < 0 || static_cast<std::size_t>(size) >= buffer.size()) {
         return false;
     }
 
-    // Calculate required length.
-    const int return_code = std::snprintf(nullptr, 0, get_format_code<T>(), value);
-    if (return_code < 0) {
-        return false;
+    std::size_t length = static_cast<std::size_t>(size);
+    if (hexadecimal) {
+        // Match std::to_chars, which does not write the "0x" prefix.
+        const std::size_t sign = buffer[0] == '-' ? 1u : 0u;
+        if (std::string_view(buffer.data() + sign, length - sign).starts_with("0x")) {
+            std::memmove(buffer.data() + sign, buffer.data() + sign + 2u, length - sign - 2u);
+            length -= 2u;
+        }
     }
 
-    // 'return_code' holds the number of characters that are required,
-    // excluding the null-terminating character, which always gets appended,
-    // so we need to +1.
-    const std::size_t length    = static_cast<std::size_t>(return_code) + 1;
-    const bool        could_fit = length <= ss.available();
+    std::string_view number(buffer.data(), length);
+#endif
 
-    const std::size_t offset     = ss.size();
-    const std::size_t prev_space = ss.available();
-    ss.resize(std::min(ss.size() + length, ss.capacity()));
-    std::snprintf(ss.begin() + offset, prev_space, get_format_code<T>(), value);
+    return snitch::impl::append_padded(ss, number, width, fill);
+}
 
-    // Pop the null-terminating character, always printed unfortunately.
-    ss.pop_back();
+// Set of the first characters of a list of patterns, used to skip quickly over the characters
+// that cannot start a match.
+struct first_characters {
+    std::array<bool, 256> table = {};
+    std::size_t           count = 0;
+    char                  last  = 0;
 
-    return could_fit;
-}
-} // namespace
+    void add(std::string_view pattern) noexcept {
+        if (pattern.empty()) {
+            return;
+        }
 
-namespace snitch {
-bool append(small_string_span ss, std::string_view str) noexcept {
-    if (str.empty()) {
-        return true;
+        bool& present = table[static_cast<unsigned char>(pattern[0])];
+        if (!present) {
+            present = true;
+            last    = pattern[0];
+            ++count;
+        }
     }
 
-    const bool        could_fit  = str.size() <= ss.available();
-    const std::size_t copy_count = std::min(str.size(), ss.available());
+    std::size_t find(std::string_view string, std::size_t pos) const noexcept {
+        if (pos >= string.size()) {
+            return string.npos;
+        }
 
-    const std::size_t offset = ss.size();
-    ss.grow(copy_count);
-    std::memmove(ss.begin() + offset, str.data(), copy_count);
+        if (count == 1) {
+            // A single candidate: memchr is vectorised by the standard library.
+            const void* found = std::memchr(string.data() + pos, last, string.size() - pos);
+            return found != nullptr ? static_cast<std::size_t>(static_cast<const char*>(found) -
+                                                               string.data())
+                                    : string.npos;
+        }
 
-    return could_fit;
-}
+        if (count != 0) {
+            for (; pos < string.size(); ++pos) {
+                if (table[static_cast<unsigned char>(string[pos])]) {
+                    return pos;
+                }
+            }
+        }
+
+        return string.npos;
+    }
+};
+} // namespace
 
+namespace snitch {
 bool append(small_string_span ss, const void* ptr) noexcept {
-    return append_fmt(ss, ptr);
+    if (ptr == nullptr) {
+        return append(ss, "nullptr");
+    }
+
+    return append(ss, "0x") &&
+           impl::append_integer(ss, reinterpret_cast<std::uintptr_t>(ptr), true, 0, ' ');
 }
 
 bool append(small_string_span ss, std::nullptr_t) noexcept {
     return append(ss, "nullptr");
 }
 
-bool append(small_string_span ss, std::size_t i) noexcept {
-    return append_fmt(ss, i);
-}
-
-bool append(small_string_span ss, std::ptrdiff_t i) noexcept {
-    return append_fmt(ss, i);
+bool impl::append_float(
+    small_string_span ss, float value, bool hexadecimal, std::size_t width, char fill) noexcept {
+    return append_to_chars(ss, value, hexadecimal, width, fill);
 }
 
-bool append(small_string_span ss, float f) noexcept {
-    return append_fmt(ss, f);
-}
-
-bool append(small_string_span ss, double d) noexcept {
-    return append_fmt(ss, d);
-}
-
-bool append(small_string_span ss, bool value) noexcept {
-    return append(ss, value ? "true" : "false");
+bool impl::append_float(
+    small_string_span ss, double value, bool hexadecimal, std::size_t width, char fill) noexcept {
+    return append_to_chars(ss, value, hexadecimal, width, fill);
 }
 
 void truncate_end(small_string_span ss) noexcept {
@@ -153,77 +405,159 @@ void truncate_end(small_string_span ss) noexcept {
 bool replace_all(
     small_string_span string, std::string_view pattern, std::string_view replacement) noexcept {
 
-    if (replacement.size() == pattern.size()) {
-        std::string_view sv(string.begin(), string.size());
-        auto             pos = sv.find(pattern);
-
-        while (pos != sv.npos) {
-            // Replace pattern by replacement
-            std::memcpy(string.data() + pos, replacement.data(), replacement.size());
-            pos += replacement.size();
+    if (pattern.empty() || pattern.size() > string.size()) {
+        return true;
+    }
 
-            // Find next occurrence
-            pos = sv.find(pattern, pos);
+    char* const       data = string.data();
+    const std::size_t size = string.size();
+
+    if (replacement.size() <= pattern.size()) {
+        // The output never gets ahead of the input, so compact the string in place, left to right.
+        const std::string_view sv(data, size);
+        std::size_t            out   = 0;
+        std::size_t            start = 0;
+        for (auto pos = sv.find(pattern); pos != sv.npos; pos = sv.find(pattern, start)) {
+            std::memmove(data + out, data + start, pos - start);
+            out += pos - start;
+            std::memcpy(data + out, replacement.data(), replacement.size());
+            out += replacement.size();
+            start = pos + pattern.size();
         }
 
+        std::memmove(data + out, data + start, size - start);
+        string.resize(out + size - start);
         return true;
-    } else if (replacement.size() < pattern.size()) {
-        const std::size_t char_diff = pattern.size() - replacement.size();
-        std::string_view  sv(string.begin(), string.size());
-        auto              pos = sv.find(pattern);
+    }
 
-        while (pos != sv.npos) {
-            // Shift data after the replacement to the left to fill the gap
-            std::rotate(string.begin() + pos, string.begin() + pos + char_diff, string.end());
-            string.resize(string.size() - char_diff);
+    // First pass: find how many input characters will fit once replaced, and whether the last
+    // replacement needs to be truncated.
+    const std::size_t      capacity    = string.capacity();
+    const std::size_t      growth      = replacement.size() - pattern.size();
+    const std::string_view sv(data, size);
+    std::size_t            total_growth = 0;
+    std::size_t            kept         = size;
+    std::size_t            partial      = 0;
+    bool                   overflow     = false;
+    for (auto pos = sv.find(pattern); pos != sv.npos;
+         pos      = sv.find(pattern, pos + pattern.size())) {
+        if (pos + total_growth + replacement.size() > capacity) {
+            overflow = true;
+            kept     = std::min(pos, capacity - total_growth);
+            partial  = capacity - total_growth - kept;
+            break;
+        }
 
-            // Replace pattern by replacement
-            std::memcpy(string.data() + pos, replacement.data(), replacement.size());
-            pos += replacement.size();
+        total_growth += growth;
+    }
 
-            // Find next occurrence
-            sv  = {string.begin(), string.size()};
-            pos = sv.find(pattern, pos);
-        }
+    if (!overflow && size + total_growth > capacity) {
+        overflow = true;
+        kept     = capacity - total_growth;
+    }
 
-        return true;
-    } else {
-        const std::size_t char_diff = replacement.size() - pattern.size();
-        std::string_view  sv(string.begin(), string.size());
-        auto              pos      = sv.find(pattern);
-        bool              overflow = false;
-
-        while (pos != sv.npos) {
-            // Shift data after the pattern to the right to make room for the replacement
-            const std::size_t char_growth = std::min(char_diff, string.available());
-            if (char_growth != char_diff) {
-                overflow = true;
-            }
-            string.grow(char_growth);
+    // Second pass: move the kept input to the end of the buffer, and write the output from the
+    // start. The output never gets ahead of the input, since the input was moved by at least
+    // the total growth.
+    string.resize(capacity);
+    const std::size_t offset = capacity - kept;
+    std::memmove(data + offset, data, kept);
 
-            if (char_diff <= string.size() && string.size() - char_diff > pos) {
-                std::rotate(string.begin() + pos, string.end() - char_diff, string.end());
-            }
+    const std::string_view input(data + offset, kept);
+    std::size_t            out   = 0;
+    std::size_t            start = 0;
+    for (auto pos = input.find(pattern); pos != input.npos; pos = input.find(pattern, start)) {
+        std::memmove(data + out, data + offset + start, pos - start);
+        out += pos - start;
+        std::memcpy(data + out, replacement.data(), replacement.size());
+        out += replacement.size();
+        start = pos + pattern.size();
+    }
+
+    std::memmove(data + out, data + offset + start, kept - start);
+    out += kept - start;
+    std::memcpy(data + out, replacement.data(), partial);
+    string.resize(out + partial);
+
+    return !overflow;
+}
+
+bool append_replaced(
+    small_string_span                   ss,
+    std::string_view                    string,
+    std::span<const string_replacement> replacements) noexcept {
+
+    first_characters first;
+    for (const auto& r : replacements) {
+        first.add(r.pattern);
+    }
 
-            // Replace pattern by replacement
-            const std::size_t max_chars = std::min(replacement.size(), string.size() - pos);
-            std::memcpy(string.data() + pos, replacement.data(), max_chars);
-            pos += max_chars;
+    std::size_t start = 0;
+    for (auto pos = first.find(string, 0); pos != string.npos; pos = first.find(string, pos)) {
+        const std::string_view rest  = string.substr(pos);
+        const auto             match = std::find_if(
+            replacements.begin(), replacements.end(), [&](const string_replacement& r) {
+                return !r.pattern.empty() && rest.starts_with(r.pattern);
+            });
 
-            // Find next occurrence
-            sv  = {string.begin(), string.size()};
-            pos = sv.find(pattern, pos);
+        if (match == replacements.end()) {
+            ++pos;
+            continue;
         }
 
-        return !overflow;
+        if (!append(ss, string.substr(start, pos - start), match->replacement)) {
+            return false;
+        }
+
+        pos   = pos + match->pattern.size();
+        start = pos;
     }
+
+    return append(ss, string.substr(start));
 }
 } // namespace snitch
 
 namespace snitch::impl {
 void stdout_print(std::string_view message) noexcept {
-    // TODO: replace this with std::print?
-    std::printf("%.*s", static_cast<int>(message.length()), message.data());
+    thread_output.print(message);
+}
+
+void stdout_flush() noexcept {
+    thread_output.flush();
+}
+
+std::FILE* stdout_file() noexcept {
+    if (stdout_stream != nullptr) {
+        return stdout_stream;
+    }
+
+#if SNITCH_HAS_POSIX_WRITE
+    // Write to a copy of the standard output, so the stream is not affected by output captures.
+    const int fd = ::dup(stdout_fd);
+    if (fd >= 0) {
+        stdout_stream = ::fdopen(fd, "w");
+        if (stdout_stream == nullptr) {
+            ::close(fd);
+        }
+    }
+#endif
+
+    if (stdout_stream == nullptr) {
+        stdout_stream = stdout;
+    }
+
+    return stdout_stream;
+}
+
+time_point_t get_current_time() noexcept {
+    using clock = std::chrono::high_resolution_clock;
+    return static_cast<time_point_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now().time_since_epoch())
+            .count());
+}
+
+float get_duration_in_seconds(time_point_t start, time_point_t end) noexcept {
+    return static_cast<float>(end - start) / 1e9f;
 }
 
 test_state& get_current_test() noexcept {
@@ -243,6 +577,14 @@ void set_current_test(test_state* current) noexcept {
     thread_current_test = current;
 }
 
+std::FILE* get_current_output() noexcept {
+    return thread_current_output;
+}
+
+void set_current_output(std::FILE* output) noexcept {
+    thread_current_output = output;
+}
+
 } // namespace snitch::impl
 
 namespace snitch::cli {
@@ -288,27 +630,228 @@ namespace snitch {
     impl::stdout_print("terminate called with message: ");
     impl::stdout_print(msg);
     impl::stdout_print("\n");
+    impl::stdout_flush();
 
     std::terminate();
 }
 } // namespace snitch
 
+namespace {
+[[noreturn]] void flush_and_terminate() noexcept {
+    snitch::impl::stdout_flush();
+    std::terminate();
+}
+
+[[noreturn]] void terminate_arena_full(const snitch::registry& r) noexcept {
+    r.print(
+        make_colored("error:", r.with_color, color::fail),
+        " max size of captures and sections reached; "
+        "please increase 'SNITCH_MAX_TEST_ARENA_SIZE' (currently ",
+        snitch::max_test_arena_size, ")\n.");
+    flush_and_terminate();
+}
+} // namespace
+
+// Test arena implementation.
+// --------------------------
+
+namespace {
+using snitch::max_test_arena_size;
+using snitch::section_id;
+using snitch::impl::section_nesting_level;
+
+// Alignment of the records, levels, and lists stored in a test arena.
+constexpr std::size_t arena_alignment = std::max(
+    {alignof(void*), alignof(std::size_t), alignof(section_id), alignof(section_nesting_level)});
+
+constexpr std::size_t align_up(std::size_t size) noexcept {
+    return (size + arena_alignment - 1u) / arena_alignment * arena_alignment;
+}
+
+constexpr std::size_t level_stride = align_up(sizeof(section_nesting_level));
+
+// Backing storage for the arenas of the test cases running on this thread.
+alignas(std::max_align_t) thread_local char thread_arena_buffer[max_test_arena_size];
+} // namespace
+
+namespace snitch::impl {
+test_arena::test_arena(char* begin, char* end) noexcept :
+    region_begin(begin),
+    region_end(begin + (end - begin) / arena_alignment * arena_alignment) {}
+
+char* test_arena::get_front() const noexcept {
+    if (last_record == nullptr) {
+        return region_begin;
+    }
+
+    return reinterpret_cast<char*>(last_record) + align_up(sizeof(record_header)) +
+           align_up(last_record->size);
+}
+
+char* test_arena::get_back() const noexcept {
+    return region_end - levels_size * level_stride;
+}
+
+std::size_t
+test_arena::get_available(std::size_t new_sections, std::size_t new_captures) const noexcept {
+    // Keep enough space to list all the sections and captures.
+    const std::size_t used = get_front() - region_begin + levels_size * level_stride;
+    const std::size_t listed =
+        (sections_size + new_sections) * sizeof(section_id) +
+        align_up((captures_size + new_captures) * sizeof(std::string_view));
+    const std::size_t total = region_end - region_begin;
+    return used + listed <= total ? total - used - listed : 0u;
+}
+
+test_arena::record_header* test_arena::add_record(std::size_t size, bool section) noexcept {
+    char* const front = get_front();
+
+    record_header* record = new (front) record_header{last_record, size, section};
+    last_record           = record;
+    if (section) {
+        ++sections_size;
+    } else {
+        ++captures_size;
+    }
+
+    return record;
+}
+
+test_arena test_arena::make_nested() const noexcept {
+    return test_arena(get_front(), get_back());
+}
+
+std::optional<small_string_span> test_arena::add_capture() noexcept {
+    const std::size_t header    = align_up(sizeof(record_header));
+    const std::size_t available = get_available(0u, 1u);
+    if (available <= header) {
+        return {};
+    }
+
+    // The capture is given the space left, rounded down so its record stays aligned, but no more
+    // than the maximum length, so a long capture does not leave the arena full.
+    const std::size_t capacity =
+        std::min(max_capture_length, (available - header) / arena_alignment * arena_alignment);
+    record_header*    record   = add_record(0u, false);
+    return small_string_span(reinterpret_cast<char*>(record) + header, capacity, &record->size);
+}
+
+bool test_arena::add_section(const section_id& section) noexcept {
+    const std::size_t header = align_up(sizeof(record_header));
+    if (get_available(1u, 0u) < header + align_up(sizeof(section_id))) {
+        return false;
+    }
+
+    record_header* record = add_record(sizeof(section_id), true);
+    new (reinterpret_cast<char*>(record) + header) section_id(section);
+    return true;
+}
+
+void test_arena::remove_last() noexcept {
+    if (last_record == nullptr) {
+        terminate_with("remove_last() called on empty arena");
+    }
+
+    if (last_record->section) {
+        --sections_size;
+    } else {
+        --captures_size;
+    }
+
+    last_record = last_record->previous;
+}
+
+void test_arena::clear() noexcept {
+    last_record   = nullptr;
+    sections_size = 0;
+    captures_size = 0;
+}
+
+test_arena::lists test_arena::list() noexcept {
+    // The sections come first, since they have the strictest alignment.
+    section_id* const       sections = reinterpret_cast<section_id*>(get_front());
+    std::string_view* const captures = reinterpret_cast<std::string_view*>(
+        reinterpret_cast<char*>(sections) + sections_size * sizeof(section_id));
+
+    std::size_t section_index = sections_size;
+    std::size_t capture_index = captures_size;
+    for (const record_header* r = last_record; r != nullptr; r = r->previous) {
+        const char* payload = reinterpret_cast<const char*>(r) + align_up(sizeof(record_header));
+        if (r->section) {
+            new (sections + --section_index)
+                section_id(*std::launder(reinterpret_cast<const section_id*>(payload)));
+        } else {
+            new (captures + --capture_index) std::string_view(payload, r->size);
+        }
+    }
+
+    return {
+        small_vector_span<const section_id>(sections, sections_size, &sections_size),
+        small_vector_span<const std::string_view>(captures, captures_size, &captures_size)};
+}
+
+std::size_t test_arena::level_count() const noexcept {
+    return levels_size;
+}
+
+section_nesting_level& test_arena::level(std::size_t index) noexcept {
+    if (index >= levels_size) {
+        terminate_with("level() called with incorrect index");
+    }
+
+    return *std::launder(
+        reinterpret_cast<section_nesting_level*>(region_end - (index + 1u) * level_stride));
+}
+
+bool test_arena::add_level() noexcept {
+    if (get_available(0u, 0u) < level_stride) {
+        return false;
+    }
+
+    ++levels_size;
+    new (get_back()) section_nesting_level{};
+    return true;
+}
+
+void test_arena::remove_level() noexcept {
+    if (levels_size == 0) {
+        terminate_with("remove_level() called on empty arena");
+    }
+
+    --levels_size;
+}
+
+void test_arena::clear_levels() noexcept {
+    levels_size = 0;
+}
+} // namespace snitch::impl
+
 // Sections implementation.
 // ------------------------
 
 namespace snitch::impl {
 section_entry_checker::~section_entry_checker() noexcept {
     if (entered) {
-        if (state.sections.levels.size() == state.sections.depth) {
+#if SNITCH_WITH_TIMINGS
+        state.reg.report_event(event::section_ended{
+            .id       = state.test.id,
+            .sections = state.arena.list().sections,
+            .duration = get_duration_in_seconds(start_time, get_current_time())});
+#else
+        state.reg.report_event(
+            event::section_ended{.id = state.test.id, .sections = state.arena.list().sections});
+#endif
+
+        if (state.arena.level_count() == state.sections.depth) {
             state.sections.leaf_executed = true;
         } else {
-            auto& child = state.sections.levels[state.sections.depth];
+            auto& child = state.arena.level(state.sections.depth);
             if (child.previous_section_id == child.max_section_id) {
-                state.sections.levels.pop_back();
+                state.arena.remove_level();
             }
         }
 
-        state.sections.current_section.pop_back();
+        state.arena.remove_last();
     }
 
     --state.sections.depth;
@@ -317,20 +860,11 @@ section_entry_checker::~section_entry_checker() noexcept {
 section_entry_checker::operator bool() noexcept {
     ++state.sections.depth;
 
-    if (state.sections.depth > state.sections.levels.size()) {
-        if (state.sections.depth > max_nested_sections) {
-            state.reg.print(
-                make_colored("error:", state.reg.with_color, color::fail),
-                " max number of nested sections reached; "
-                "please increase 'SNITCH_MAX_NESTED_SECTIONS' (currently ",
-                max_nested_sections, ")\n.");
-            std::terminate();
-        }
-
-        state.sections.levels.push_back({});
+    if (state.sections.depth > state.arena.level_count() && !state.arena.add_level()) {
+        terminate_arena_full(state.reg);
     }
 
-    auto& level = state.sections.levels[state.sections.depth - 1];
+    auto& level = state.arena.level(state.sections.depth - 1);
 
     ++level.current_section_id;
     if (level.max_section_id < level.current_section_id) {
@@ -340,11 +874,18 @@ section_entry_checker::operator bool() noexcept {
     if (!state.sections.leaf_executed &&
         (level.previous_section_id + 1 == level.current_section_id ||
          (level.previous_section_id == level.current_section_id &&
-          state.sections.levels.size() > state.sections.depth))) {
+          state.arena.level_count() > state.sections.depth))) {
+
+        if (!state.arena.add_section(section)) {
+            terminate_arena_full(state.reg);
+        }
 
         level.previous_section_id = level.current_section_id;
-        state.sections.current_section.push_back(section);
-        entered = true;
+        entered                   = true;
+#if SNITCH_WITH_TIMINGS
+        start_time = get_current_time();
+#endif
+        state.reg.report_event(event::section_started{state.test.id, state.arena.list().sections});
         return true;
     }
 
@@ -404,19 +945,13 @@ std::string_view extract_next_name(std::string_view& names) noexcept {
     return result;
 }
 
-small_string<max_capture_length>& add_capture(test_state& state) noexcept {
-    if (state.captures.available() == 0) {
-        state.reg.print(
-            make_colored("error:", state.reg.with_color, color::fail),
-            " max number of captures reached; "
-            "please increase 'SNITCH_MAX_CAPTURES' (currently ",
-            max_captures, ")\n.");
-        std::terminate();
+small_string_span add_capture(test_state& state) noexcept {
+    auto capture = state.arena.add_capture();
+    if (!capture) {
+        terminate_arena_full(state.reg);
     }
 
-    state.captures.grow(1);
-    state.captures.back().clear();
-    return state.captures.back();
+    return *capture;
 }
 } // namespace snitch::impl
 
@@ -530,15 +1065,15 @@ void for_each_tag(std::string_view s, F&& callback) noexcept {
 
 template<typename F>
 bool run_tests(registry& r, std::string_view run_name, F&& predicate) noexcept {
-    if (!r.report_callback.empty()) {
-        r.report_callback(r, event::test_run_started{run_name});
-    } else if (is_at_least(r.verbose, registry::verbosity::normal)) {
-        r.print(
-            make_colored("starting tests with ", r.with_color, color::highlight2),
-            make_colored("snitch v" SNITCH_FULL_VERSION "\n", r.with_color, color::highlight1));
-        r.print("==========================================\n");
+    std::size_t test_count = 0;
+    for (const test_case& t : r) {
+        if (predicate(t)) {
+            ++test_count;
+        }
     }
 
+    r.report_event(event::test_run_started{.name = run_name, .test_count = test_count});
+
     bool        success         = true;
     std::size_t run_count       = 0;
     std::size_t fail_count      = 0;
@@ -546,8 +1081,7 @@ bool run_tests(registry& r, std::string_view run_name, F&& predicate) noexcept {
     std::size_t assertion_count = 0;
 
 #if SNITCH_WITH_TIMINGS
-    using clock     = std::chrono::high_resolution_clock;
-    auto time_start = clock::now();
+    const auto time_start = impl::get_current_time();
 #endif
 
     for (test_case& t : r) {
@@ -582,54 +1116,29 @@ bool run_tests(registry& r, std::string_view run_name, F&& predicate) noexcept {
     }
 
 #if SNITCH_WITH_TIMINGS
-    auto  time_end = clock::now();
-    float duration = std::chrono::duration<float>(time_end - time_start).count();
+    const float duration = impl::get_duration_in_seconds(time_start, impl::get_current_time());
 #endif
 
-    if (!r.report_callback.empty()) {
 #if SNITCH_WITH_TIMINGS
-        r.report_callback(
-            r, event::test_run_ended{
-                   .name            = run_name,
-                   .success         = success,
-                   .run_count       = run_count,
-                   .fail_count      = fail_count,
-                   .skip_count      = skip_count,
-                   .assertion_count = assertion_count,
-                   .duration        = duration});
+    r.report_event(event::test_run_ended{
+        .name            = run_name,
+        .success         = success,
+        .run_count       = run_count,
+        .fail_count      = fail_count,
+        .skip_count      = skip_count,
+        .assertion_count = assertion_count,
+        .duration        = duration});
 #else
-        r.report_callback(
-            r, event::test_run_ended{
-                   .name            = run_name,
-                   .success         = success,
-                   .run_count       = run_count,
-                   .fail_count      = fail_count,
-                   .skip_count      = skip_count,
-                   .assertion_count = assertion_count});
-#endif
-    } else if (is_at_least(r.verbose, registry::verbosity::normal)) {
-        r.print("==========================================\n");
-
-        if (success) {
-            r.print(
-                make_colored("success:", r.with_color, color::pass), " all tests passed (",
-                run_count, " test cases, ", assertion_count, " assertions");
-        } else {
-            r.print(
-                make_colored("error:", r.with_color, color::fail), " some tests failed (",
-                fail_count, " out of ", run_count, " test cases, ", assertion_count, " assertions");
-        }
-
-        if (skip_count > 0) {
-            r.print(", ", skip_count, " test cases skipped");
-        }
-
-#if SNITCH_WITH_TIMINGS
-        r.print(", ", duration, " seconds");
+    r.report_event(event::test_run_ended{
+        .name            = run_name,
+        .success         = success,
+        .run_count       = run_count,
+        .fail_count      = fail_count,
+        .skip_count      = skip_count,
+        .assertion_count = assertion_count});
 #endif
 
-        r.print(")\n");
-    }
+    impl::stdout_flush();
 
     return success;
 }
@@ -672,104 +1181,389 @@ void set_state(test_case& t, impl::test_case_state s) noexcept {
     }
 }
 
-snitch::test_case_state convert_to_public_state(impl::test_case_state s) noexcept {
-    switch (s) {
-    case impl::test_case_state::success: return snitch::test_case_state::success;
-    case impl::test_case_state::failed: return snitch::test_case_state::failed;
-    case impl::test_case_state::skipped: return snitch::test_case_state::skipped;
-    default: terminate_with("test case state cannot be exposed to the public");
+snitch::test_case_state convert_to_public_state(impl::test_case_state s) noexcept {
+    switch (s) {
+    case impl::test_case_state::success: return snitch::test_case_state::success;
+    case impl::test_case_state::failed: return snitch::test_case_state::failed;
+    case impl::test_case_state::skipped: return snitch::test_case_state::skipped;
+    default: terminate_with("test case state cannot be exposed to the public");
+    }
+}
+
+bool register_failure(
+    test_state& state, const assertion_location& location, std::size_t max_failures) noexcept {
+    if (max_failures == 0) {
+        return true;
+    }
+
+    for (auto& site : state.failures) {
+        if (site.line == location.line && site.file == location.file) {
+            ++site.count;
+            return site.count <= max_failures;
+        }
+    }
+
+    if (state.failures.available() != 0) {
+        state.failures.push_back({location.file, location.line, 1u});
+    }
+
+    return true;
+}
+
+void print_location(
+    const registry&           r,
+    const test_id&            id,
+    const section_info&       sections,
+    const capture_info&       captures,
+    const assertion_location& location) noexcept {
+
+    r.print("running test case \"", make_colored(id.name, r.with_color, color::highlight1), "\"\n");
+
+    for (auto& section : sections) {
+        r.print(
+            "          in section \"", make_colored(section.name, r.with_color, color::highlight1),
+            "\"\n");
+    }
+
+    r.print("          at ", location.file, ":", location.line, "\n");
+
+    if (!id.type.empty()) {
+        r.print(
+            "          for type ", make_colored(id.type, r.with_color, color::highlight1), "\n");
+    }
+
+    for (auto& capture : captures) {
+        r.print("          with ", make_colored(capture, r.with_color, color::highlight1), "\n");
+    }
+}
+
+void print_failure(const registry& r, bool expected) noexcept {
+    if (expected) {
+        r.print(make_colored("expected failure: ", r.with_color, color::pass));
+    } else {
+        r.print(make_colored("failed: ", r.with_color, color::fail));
     }
 }
 
-small_vector<std::string_view, max_captures> make_capture_buffer(const capture_state& captures) {
-    small_vector<std::string_view, max_captures> captures_buffer;
-    for (const auto& c : captures) {
-        captures_buffer.push_back(c);
-    }
+void print_details(const registry& r, std::string_view message) noexcept {
+    r.print("          ", make_colored(message, r.with_color, color::highlight2), "\n");
+}
 
-    return captures_buffer;
+void print_output(const registry& r, const test_id& id, std::string_view output) noexcept {
+    r.print(
+        make_colored("output:", r.with_color, color::status), " captured from test case \"",
+        make_colored(id.name, r.with_color, color::highlight1), "\"\n");
+    r.print_message(output);
+    if (!output.ends_with('\n')) {
+        r.print("\n");
+    }
 }
 } // namespace
 
+namespace snitch::console {
+void report(const registry& r, const event::data& event) noexcept {
+    std::visit(
+        snitch::overload{
+            [&](const event::test_run_started&) {
+                if (!is_at_least(r.verbose, registry::verbosity::normal)) {
+                    return;
+                }
+
+                r.print(
+                    make_colored("starting tests with ", r.with_color, color::highlight2),
+                    make_colored(
+                        "snitch v" SNITCH_FULL_VERSION "\n", r.with_color, color::highlight1));
+                r.print("==========================================\n");
+            },
+            [&](const event::test_run_ended& e) {
+                if (!is_at_least(r.verbose, registry::verbosity::normal)) {
+                    return;
+                }
+
+                r.print("==========================================\n");
+
+                if (e.success) {
+                    r.print(
+                        make_colored("success:", r.with_color, color::pass), " all tests passed (",
+                        e.run_count, " test cases, ", e.assertion_count, " assertions");
+                } else {
+                    r.print(
+                        make_colored("error:", r.with_color, color::fail), " some tests failed (",
+                        e.fail_count, " out of ", e.run_count, " test cases, ", e.assertion_count,
+                        " assertions");
+                }
+
+                if (e.skip_count > 0) {
+                    r.print(", ", e.skip_count, " test cases skipped");
+                }
+
+#if SNITCH_WITH_TIMINGS
+                r.print(", ", e.duration, " seconds");
+#endif
+
+                r.print(")\n");
+            },
+            [&](const event::test_case_started& e) {
+                if (!is_at_least(r.verbose, registry::verbosity::high)) {
+                    return;
+                }
+
+                small_string<max_test_name_length> full_name;
+                make_full_name(full_name, e.id);
+                r.print(
+                    make_colored("starting:", r.with_color, color::status), " ",
+                    make_colored(full_name, r.with_color, color::highlight1), "\n");
+            },
+            [&](const event::test_case_ended& e) {
+                if (!e.output.empty()) {
+                    print_output(r, e.id, e.output);
+                }
+
+                if (!is_at_least(r.verbose, registry::verbosity::high)) {
+                    return;
+                }
+
+                small_string<max_test_name_length> full_name;
+                make_full_name(full_name, e.id);
+#if SNITCH_WITH_TIMINGS
+                r.print(
+                    make_colored("finished:", r.with_color, color::status), " ",
+                    make_colored(full_name, r.with_color, color::highlight1), " (", e.duration,
+                    "s)\n");
+#else
+                r.print(
+                    make_colored("finished:", r.with_color, color::status), " ",
+                    make_colored(full_name, r.with_color, color::highlight1), "\n");
+#endif
+            },
+            [&](const event::section_started&) {},
+            [&](const event::section_ended&) {},
+            [&](const event::assertion_failed& e) {
+                print_failure(r, e.expected);
+                print_location(r, e.id, e.sections, e.captures, e.location);
+                print_details(r, e.message);
+            },
+            [&](const event::assertion_passed&) {},
+            [&](const event::assertion_failures_suppressed& e) {
+                r.print(
+                    "          ... and ", e.count, " more failures at ", e.location.file, ":",
+                    e.location.line, "\n");
+            },
+            [&](const event::test_case_skipped& e) {
+                r.print(make_colored("skipped: ", r.with_color, color::skipped));
+                print_location(r, e.id, e.sections, e.captures, e.location);
+                print_details(r, e.message);
+            }},
+        event);
+}
+} // namespace snitch::console
+
 namespace snitch {
 const char* registry::add(const test_id& id, test_ptr func) noexcept {
-    if (test_list.size() == test_list.capacity()) {
+    if (test_storage.size() == test_storage.capacity()) {
         print(
             make_colored("error:", with_color, color::fail),
-            " max number of test cases reached; "
+            " max number of test cases added at run time reached; "
             "please increase 'SNITCH_MAX_TEST_CASES' (currently ",
             max_test_cases, ")\n.");
-        std::terminate();
+        flush_and_terminate();
     }
 
-    test_list.push_back(test_case{id, func});
+    test_storage.push_back(test_case{id, func});
+    return add(test_storage.back());
+}
 
+const char* registry::add(test_case& test) noexcept {
     small_string<max_test_name_length> buffer;
-    if (make_full_name(buffer, test_list.back().id).empty()) {
+    if (make_full_name(buffer, test.id).empty()) {
         print(
             make_colored("error:", with_color, color::fail),
             " max length of test name reached; "
             "please increase 'SNITCH_MAX_TEST_NAME_LENGTH' (currently ",
             max_test_name_length, ")\n.");
-        std::terminate();
+        flush_and_terminate();
+    }
+
+    // Appending to the end of the list keeps the declaration order, in constant time.
+    test.next = nullptr;
+    if (last_test != nullptr) {
+        last_test->next = &test;
+    } else {
+        first_test = &test;
     }
 
-    return id.name.data();
+    last_test = &test;
+
+    return test.id.name.data();
+}
+
+void registry::print_message(std::string_view message) const noexcept {
+    if (std::FILE* output = impl::get_current_output(); output != nullptr) {
+        std::fwrite(message.data(), 1u, message.size(), output);
+    } else {
+        print_callback(message);
+    }
 }
 
-void registry::print_location(
-    const impl::test_case&     current_case,
-    const impl::section_state& sections,
-    const impl::capture_state& captures,
-    const assertion_location&  location) const noexcept {
+std::string_view registry::add_reporter(std::string_view name, reporter_factory factory) noexcept {
+    for (const auto& reporter : registered_reporters) {
+        if (reporter.name != name) {
+            continue;
+        }
+
+        if (reporter.factory != factory) {
+            print(
+                make_colored("error:", with_color, color::fail),
+                " a different reporter was already registered with the name '", name, "'\n");
+            flush_and_terminate();
+        }
 
-    print(
-        "running test case \"", make_colored(current_case.id.name, with_color, color::highlight1),
-        "\"\n");
+        return name;
+    }
 
-    for (auto& section : sections.current_section) {
+    if (registered_reporters.size() == registered_reporters.capacity()) {
         print(
-            "          in section \"", make_colored(section.name, with_color, color::highlight1),
-            "\"\n");
+            make_colored("error:", with_color, color::fail),
+            " max number of reporters reached; "
+            "please increase 'SNITCH_MAX_REPORTERS' (currently ",
+            max_reporters, ")\n");
+        flush_and_terminate();
+    }
+
+    registered_reporters.push_back(registered_reporter{name, factory});
+    return name;
+}
+
+bool registry::select_reporter(std::string_view specification) noexcept {
+    constexpr std::string_view separator = "::";
+    constexpr std::string_view out_key   = "out=";
+
+    const std::size_t      name_end = specification.find(separator);
+    const std::string_view name     = specification.substr(0, name_end);
+    std::string_view       options  = name_end == specification.npos
+                                          ? std::string_view{}
+                                          : specification.substr(name_end + separator.size());
+
+    // The selected reporter keeps the registered name, which outlives the specification.
+    std::string_view registered_name = {};
+    reporter_factory factory         = nullptr;
+    for (const auto& reporter : registered_reporters) {
+        if (reporter.name == name) {
+            registered_name = reporter.name;
+            factory         = reporter.factory;
+            break;
+        }
     }
 
-    print("          at ", location.file, ":", location.line, "\n");
+    if (factory == nullptr && name == "console") {
+        registered_name = "console";
+        factory = [](std::FILE*) noexcept -> report_function { return &console::report; };
+    }
 
-    if (!current_case.id.type.empty()) {
+    if (factory == nullptr) {
         print(
-            "          for type ",
-            make_colored(current_case.id.type, with_color, color::highlight1), "\n");
+            make_colored("error:", with_color, color::fail), " unknown reporter '", name, "'\n");
+        return false;
     }
 
-    for (auto& capture : captures) {
-        print("          with ", make_colored(capture, with_color, color::highlight1), "\n");
+    for (const auto& reporter : selected_reporters) {
+        if (reporter.name == name) {
+            print(
+                make_colored("error:", with_color, color::fail), " reporter '", name,
+                "' is already selected\n");
+            return false;
+        }
     }
-}
 
-void registry::print_failure() const noexcept {
-    print(make_colored("failed: ", with_color, color::fail));
-}
+    if (selected_reporters.size() == selected_reporters.capacity()) {
+        print(
+            make_colored("error:", with_color, color::fail),
+            " max number of selected reporters reached; "
+            "please increase 'SNITCH_MAX_REPORTERS' (currently ",
+            max_reporters, ")\n");
+        return false;
+    }
 
-void registry::print_expected_failure() const noexcept {
-    print(make_colored("expected failure: ", with_color, color::pass));
-}
+    // The file name must be null-terminated for fopen().
+    small_string<max_message_length> output_path;
+    while (!options.empty()) {
+        const std::size_t      option_end = options.find(separator);
+        const std::string_view option     = options.substr(0, option_end);
+        options                           = option_end == options.npos
+                                                ? std::string_view{}
+                                                : options.substr(option_end + separator.size());
+
+        if (!option.starts_with(out_key) || option.size() == out_key.size()) {
+            print(
+                make_colored("error:", with_color, color::fail), " unknown option '", option,
+                "' for reporter '", name, "'; please use out=<file>\n");
+            return false;
+        }
+
+        output_path.clear();
+        if (!append(output_path, option.substr(out_key.size())) ||
+            output_path.available() == 0u) {
+            print(
+                make_colored("error:", with_color, color::fail),
+                " output file name is too long for reporter '", name, "'\n");
+            return false;
+        }
+
+        output_path.push_back('\0');
+    }
+
+    std::FILE* output = nullptr;
+    if (!output_path.empty()) {
+        output = std::fopen(output_path.data(), "w");
+        if (output == nullptr) {
+            print(
+                make_colored("error:", with_color, color::fail), " could not open '",
+                output_path.str().substr(0, output_path.size() - 1u), "' for reporter '", name,
+                "'\n");
+            return false;
+        }
+    }
 
-void registry::print_skip() const noexcept {
-    print(make_colored("skipped: ", with_color, color::skipped));
+    selected_reporters.push_back(selected_reporter{registered_name, factory(output), output});
+    return true;
 }
 
-void registry::print_details(std::string_view message) const noexcept {
-    print("          ", make_colored(message, with_color, color::highlight2), "\n");
+void registry::clear_reporters() noexcept {
+    for (const auto& reporter : selected_reporters) {
+        if (reporter.output != nullptr) {
+            std::fclose(reporter.output);
+        }
+    }
+
+    selected_reporters.clear();
 }
 
-void registry::print_details_expr(const expression& exp) const noexcept {
-    print("          ", make_colored(exp.expected, with_color, color::highlight2));
+void registry::report_event(const event::data& event) const noexcept {
+    if (selected_reporters.empty()) {
+        if (!report_callback.empty()) {
+            report_callback(*this, event);
+        } else {
+            console::report(*this, event);
+        }
+
+        return;
+    }
 
-    if (!exp.actual.empty()) {
-        print(", got ", make_colored(exp.actual, with_color, color::highlight2));
+    std::FILE* const previous_output = impl::get_current_output();
+    for (const auto& reporter : selected_reporters) {
+        impl::set_current_output(reporter.output);
+        reporter.callback(*this, event);
     }
 
-    print("\n");
+    impl::set_current_output(previous_output);
+
+    if (std::holds_alternative<event::test_run_ended>(event)) {
+        for (const auto& reporter : selected_reporters) {
+            if (reporter.output != nullptr) {
+                std::fflush(reporter.output);
+            }
+        }
+    }
 }
 
 void registry::report_failure(
@@ -781,21 +1575,14 @@ void registry::report_failure(
         set_state(state.test, impl::test_case_state::failed);
     }
 
-    if (!report_callback.empty()) {
-        const auto captures_buffer = make_capture_buffer(state.captures);
-        report_callback(
-            *this, event::assertion_failed{
-                       state.test.id, state.sections.current_section, captures_buffer.span(),
-                       location, message, state.should_fail, state.may_fail});
-    } else {
-        if (state.should_fail) {
-            print_expected_failure();
-        } else {
-            print_failure();
-        }
-        print_location(state.test, state.sections, state.captures, location);
-        print_details(message);
+    if (!register_failure(state, location, max_failures_per_site)) {
+        return;
     }
+
+    const auto lists = state.arena.list();
+    report_event(event::assertion_failed{
+        state.test.id, lists.sections, lists.captures, location, message, state.should_fail,
+        state.may_fail});
 }
 
 void registry::report_failure(
@@ -808,24 +1595,17 @@ void registry::report_failure(
         set_state(state.test, impl::test_case_state::failed);
     }
 
+    if (!register_failure(state, location, max_failures_per_site)) {
+        return;
+    }
+
     small_string<max_message_length> message;
     append_or_truncate(message, message1, message2);
 
-    if (!report_callback.empty()) {
-        const auto captures_buffer = make_capture_buffer(state.captures);
-        report_callback(
-            *this, event::assertion_failed{
-                       state.test.id, state.sections.current_section, captures_buffer.span(),
-                       location, message, state.should_fail, state.may_fail});
-    } else {
-        if (state.should_fail) {
-            print_expected_failure();
-        } else {
-            print_failure();
-        }
-        print_location(state.test, state.sections, state.captures, location);
-        print_details(message);
-    }
+    const auto lists = state.arena.list();
+    report_event(event::assertion_failed{
+        state.test.id, lists.sections, lists.captures, location, message, state.should_fail,
+        state.may_fail});
 }
 
 void registry::report_failure(
@@ -833,34 +1613,14 @@ void registry::report_failure(
     const assertion_location& location,
     const impl::expression&   exp) const noexcept {
 
-    if (!state.may_fail) {
-        set_state(state.test, impl::test_case_state::failed);
+    if (exp.actual.empty()) {
+        report_failure(state, location, exp.expected);
+        return;
     }
 
-    if (!report_callback.empty()) {
-        const auto captures_buffer = make_capture_buffer(state.captures);
-        if (!exp.actual.empty()) {
-            small_string<max_message_length> message;
-            append_or_truncate(message, exp.expected, ", got ", exp.actual);
-            report_callback(
-                *this, event::assertion_failed{
-                           state.test.id, state.sections.current_section, captures_buffer.span(),
-                           location, message, state.should_fail, state.may_fail});
-        } else {
-            report_callback(
-                *this, event::assertion_failed{
-                           state.test.id, state.sections.current_section, captures_buffer.span(),
-                           location, exp.expected, state.should_fail, state.may_fail});
-        }
-    } else {
-        if (state.should_fail) {
-            print_expected_failure();
-        } else {
-            print_failure();
-        }
-        print_location(state.test, state.sections, state.captures, location);
-        print_details_expr(exp);
-    }
+    small_string<max_message_length> message;
+    append_or_truncate(message, exp.expected, ", got ", exp.actual);
+    report_failure(state, location, message.str());
 }
 
 void registry::report_skipped(
@@ -870,30 +1630,20 @@ void registry::report_skipped(
 
     set_state(state.test, impl::test_case_state::skipped);
 
-    if (!report_callback.empty()) {
-        const auto captures_buffer = make_capture_buffer(state.captures);
-        report_callback(
-            *this, event::test_case_skipped{
-                       state.test.id, state.sections.current_section, captures_buffer.span(),
-                       location, message});
-    } else {
-        print_skip();
-        print_location(state.test, state.sections, state.captures, location);
-        print_details(message);
-    }
+    const auto lists = state.arena.list();
+    report_event(
+        event::test_case_skipped{state.test.id, lists.sections, lists.captures, location, message});
 }
 
-test_state registry::run(test_case& test) noexcept {
-    small_string<max_test_name_length> full_name;
+void registry::report_assertion_passed(
+    impl::test_state& state, const assertion_location& location) const noexcept {
 
-    if (!report_callback.empty()) {
-        report_callback(*this, event::test_case_started{test.id});
-    } else if (is_at_least(verbose, verbosity::high)) {
-        make_full_name(full_name, test.id);
-        print(
-            make_colored("starting:", with_color, color::status), " ",
-            make_colored(full_name, with_color, color::highlight1), "\n");
-    }
+    const auto lists = state.arena.list();
+    report_event(event::assertion_passed{state.test.id, lists.sections, lists.captures, location});
+}
+
+test_state registry::run(test_case& test) noexcept {
+    report_event(event::test_case_started{test.id});
 
     test.state = impl::test_case_state::success;
 
@@ -907,21 +1657,33 @@ test_state registry::run(test_case& test) noexcept {
         }
     });
 
-    test_state state{.reg = *this, .test = test, .may_fail = may_fail, .should_fail = should_fail};
-
     // Store previously running test, to restore it later.
     // This should always be a null pointer, except when testing snitch itself.
     test_state* previous_run = thread_current_test;
-    thread_current_test      = &state;
+
+    // A test case running inside another one gets the space its parent is not using.
+    test_state state{
+        .reg   = *this,
+        .test  = test,
+        .arena = previous_run != nullptr
+                     ? previous_run->arena.make_nested()
+                     : test_arena(std::begin(thread_arena_buffer), std::end(thread_arena_buffer)),
+        .may_fail    = may_fail,
+        .should_fail = should_fail};
+
+    thread_current_test = &state;
+
+    impl::stdout_flush();
+
+    const bool capturing = capture_output && process_output.start();
 
 #if SNITCH_WITH_TIMINGS
-    using clock     = std::chrono::high_resolution_clock;
-    auto time_start = clock::now();
+    const auto time_start = impl::get_current_time();
 #endif
 
     do {
-        for (std::size_t i = 0; i < state.sections.levels.size(); ++i) {
-            state.sections.levels[i].current_section_id = 0;
+        for (std::size_t i = 0; i < state.arena.level_count(); ++i) {
+            state.arena.level(i).current_section_id = 0;
         }
 
         state.sections.leaf_executed = false;
@@ -941,14 +1703,14 @@ test_state registry::run(test_case& test) noexcept {
         test.func();
 #endif
 
-        if (state.sections.levels.size() == 1) {
-            auto& child = state.sections.levels[0];
+        if (state.arena.level_count() == 1) {
+            auto& child = state.arena.level(0);
             if (child.previous_section_id == child.max_section_id) {
-                state.sections.levels.clear();
-                state.sections.current_section.clear();
+                state.arena.clear_levels();
+                state.arena.clear();
             }
         }
-    } while (!state.sections.levels.empty());
+    } while (state.arena.level_count() != 0);
 
     if (state.should_fail) {
         if (state.test.state == impl::test_case_state::success) {
@@ -960,40 +1722,47 @@ test_state registry::run(test_case& test) noexcept {
         }
     }
 
-#if SNITCH_WITH_TIMINGS
-    auto time_end  = clock::now();
-    state.duration = std::chrono::duration<float>(time_end - time_start).count();
-#endif
+    if (max_failures_per_site != 0) {
+        for (const auto& site : state.failures) {
+            if (site.count <= max_failures_per_site) {
+                continue;
+            }
+
+            const std::size_t        suppressed = site.count - max_failures_per_site;
+            const assertion_location location{site.file, site.line};
+            report_event(event::assertion_failures_suppressed{test.id, location, suppressed});
+        }
+    }
 
-    if (!report_callback.empty()) {
 #if SNITCH_WITH_TIMINGS
-        report_callback(
-            *this, event::test_case_ended{
-                       .id              = test.id,
-                       .state           = convert_to_public_state(state.test.state),
-                       .assertion_count = state.asserts,
-                       .duration        = state.duration});
-#else
-        report_callback(
-            *this, event::test_case_ended{
-                       .id              = test.id,
-                       .state           = convert_to_public_state(state.test.state),
-                       .assertion_count = state.asserts});
+    state.duration = impl::get_duration_in_seconds(time_start, impl::get_current_time());
 #endif
-    } else if (is_at_least(verbose, verbosity::high)) {
+
+    // The output of test cases which did not fail is discarded.
+    small_string<max_captured_output> output;
+    if (capturing) {
+        process_output.stop(output, state.test.state == impl::test_case_state::failed);
+    }
+
 #if SNITCH_WITH_TIMINGS
-        print(
-            make_colored("finished:", with_color, color::status), " ",
-            make_colored(full_name, with_color, color::highlight1), " (", state.duration, "s)\n");
+    report_event(event::test_case_ended{
+        .id              = test.id,
+        .state           = convert_to_public_state(state.test.state),
+        .assertion_count = state.asserts,
+        .duration        = state.duration,
+        .output          = output});
 #else
-        print(
-            make_colored("finished:", with_color, color::status), " ",
-            make_colored(full_name, with_color, color::highlight1), "\n");
+    report_event(event::test_case_ended{
+        .id              = test.id,
+        .state           = convert_to_public_state(state.test.state),
+        .assertion_count = state.asserts,
+        .output          = output});
 #endif
-    }
 
     thread_current_test = previous_run;
 
+    impl::stdout_flush();
+
     return state;
 }
 
@@ -1027,7 +1796,7 @@ bool registry::run_tests_with_tag(std::string_view run_name, std::string_view ta
         print(
             make_colored("error:", with_color, color::fail),
             " tag must be of the form '[tag_name]'.");
-        std::terminate();
+        flush_and_terminate();
     }
 
     return ::run_tests(*this, run_name, [&](const test_case& t) {
@@ -1044,7 +1813,7 @@ bool registry::run_tests_with_tag(std::string_view run_name, std::string_view ta
 
 void registry::list_all_tags() const noexcept {
     small_vector<std::string_view, max_unique_tags> tags;
-    for (const auto& t : test_list) {
+    for (const test_case& t : *this) {
         for_each_tag(t.id.tags, [&](const tags::parsed_tag& v) {
             if (auto* vs = std::get_if<std::string_view>(&v); vs != nullptr) {
                 if (std::find(tags.begin(), tags.end(), *vs) == tags.end()) {
@@ -1054,7 +1823,7 @@ void registry::list_all_tags() const noexcept {
                             " max number of tags reached; "
                             "please increase 'SNITCH_MAX_UNIQUE_TAGS' (currently ",
                             max_unique_tags, ")\n.");
-                        std::terminate();
+                        flush_and_terminate();
                     }
 
                     tags.push_back(*vs);
@@ -1080,7 +1849,7 @@ void registry::list_tests_with_tag(std::string_view tag) const noexcept {
         print(
             make_colored("error:", with_color, color::fail),
             " tag must be of the form '[tag_name]'.");
-        std::terminate();
+        flush_and_terminate();
     }
 
     list_tests(*this, [&](const test_case& t) {
@@ -1095,27 +1864,253 @@ void registry::list_tests_with_tag(std::string_view tag) const noexcept {
     });
 }
 
-test_case* registry::begin() noexcept {
-    return test_list.begin();
+test_case_iterator<test_case> registry::begin() noexcept {
+    return test_case_iterator<test_case>{first_test};
+}
+
+test_case_iterator<test_case> registry::end() noexcept {
+    return {};
+}
+
+test_case_iterator<const test_case> registry::begin() const noexcept {
+    return test_case_iterator<const test_case>{first_test};
+}
+
+test_case_iterator<const test_case> registry::end() const noexcept {
+    return {};
+}
+
+constinit registry tests;
+} // namespace snitch
+
+// Assertion coverage implementation.
+// ----------------------------------
+
+#if SNITCH_WITH_ASSERTION_EVENTS
+namespace {
+using snitch::max_assertion_sites;
+using snitch::small_vector;
+
+struct assertion_site_entry {
+    std::size_t file = 0u;
+    std::size_t line = 0u;
+};
+
+constexpr std::size_t max_bitmap_size = (max_assertion_sites + 7u) / 8u;
+
+// Assertion sites are registered during static initialization; constinit ensures the tables are
+// ready before that, regardless of the initialization order of translation units.
+constinit small_vector<std::string_view, max_assertion_sites>     site_files;
+constinit small_vector<assertion_site_entry, max_assertion_sites> sites;
+constinit std::array<unsigned char, max_bitmap_size>              executed_sites = {};
+constinit bool                                                    too_many_sites = false;
+
+bool write_varint(std::FILE* file, std::size_t value) noexcept {
+    unsigned char bytes[16];
+    std::size_t   size = 0u;
+    do {
+        bytes[size] = static_cast<unsigned char>(value & 0x7fu);
+        value >>= 7u;
+        if (value != 0u) {
+            bytes[size] |= 0x80u;
+        }
+        ++size;
+    } while (value != 0u);
+
+    return std::fwrite(bytes, 1u, size, file) == size;
+}
+} // namespace
+
+namespace snitch::impl {
+std::size_t register_assertion_site(std::string_view file, std::size_t line) noexcept {
+    if (sites.available() == 0u) {
+        too_many_sites = true;
+        return max_assertion_sites;
+    }
+
+    std::size_t file_index = 0u;
+    while (file_index < site_files.size() && site_files[file_index] != file) {
+        ++file_index;
+    }
+
+    if (file_index == site_files.size()) {
+        site_files.push_back(file);
+    }
+
+    sites.push_back({file_index, line});
+    return sites.size() - 1u;
 }
 
-test_case* registry::end() noexcept {
-    return test_list.end();
+void mark_assertion_site(std::size_t index) noexcept {
+    if (index < max_assertion_sites) {
+        executed_sites[index / 8u] |= static_cast<unsigned char>(1u << (index % 8u));
+    }
 }
+} // namespace snitch::impl
 
-const test_case* registry::begin() const noexcept {
-    return test_list.begin();
+namespace snitch {
+bool write_assertion_coverage(std::FILE* file) noexcept {
+    bool success = std::fwrite("SNCV\x01", 1u, 5u, file) == 5u;
+
+    success = success && write_varint(file, site_files.size());
+    for (const auto& f : site_files) {
+        success = success && write_varint(file, f.size()) &&
+                  std::fwrite(f.data(), 1u, f.size(), file) == f.size();
+    }
+
+    success = success && write_varint(file, sites.size());
+    for (const auto& site : sites) {
+        success = success && write_varint(file, site.file) && write_varint(file, site.line);
+    }
+
+    const std::size_t bitmap_size = (sites.size() + 7u) / 8u;
+    success = success && std::fwrite(executed_sites.data(), 1u, bitmap_size, file) == bitmap_size;
+
+    return success && std::fflush(file) == 0 && !too_many_sites;
+}
+} // namespace snitch
+#else
+namespace snitch {
+bool write_assertion_coverage(std::FILE*) noexcept {
+    return false;
 }
+} // namespace snitch
+#endif
+
+// Event copy implementation.
+// --------------------------
+
+namespace {
+std::string_view copy_string(small_string_span buffer, std::string_view str) noexcept {
+    const std::size_t offset = buffer.size();
+    const std::size_t length = std::min(str.size(), buffer.available());
+    buffer.append_range(str.substr(0, length));
 
-const test_case* registry::end() const noexcept {
-    return test_list.end();
+    return {buffer.begin() + offset, length};
 }
+} // namespace
+
+namespace snitch {
+void event_copy::assign(const event::data& e) noexcept {
+    strings.clear();
+    sections.clear();
+    captures.clear();
+
+    const auto copy_id = [&](const test_id& other) {
+        id.name = copy_string(strings, other.name);
+        id.tags = copy_string(strings, other.tags);
+        id.type = copy_string(strings, other.type);
+    };
+
+    const auto copy_location = [&](const assertion_location& other) {
+        location.file = copy_string(strings, other.file);
+        location.line = other.line;
+    };
+
+    const auto copy_sections = [&](const section_info& other) {
+        for (const auto& s : other) {
+            if (sections.available() == 0) {
+                break;
+            }
+
+            sections.push_back(
+                {copy_string(strings, s.name), copy_string(strings, s.description)});
+        }
+    };
 
-constinit registry tests = []() {
-    registry r;
-    r.with_color = SNITCH_DEFAULT_WITH_COLOR == 1;
-    return r;
-}();
+    const auto copy_captures = [&](const capture_info& other) {
+        for (const auto& c : other) {
+            if (captures.available() == 0) {
+                break;
+            }
+
+            captures.push_back(copy_string(strings, c));
+        }
+    };
+
+    std::visit(
+        snitch::overload{
+            [&](const event::test_run_started& s) {
+                data.emplace<event::test_run_started>(
+                    event::test_run_started{
+                        .name = copy_string(strings, s.name), .test_count = s.test_count});
+            },
+            [&](const event::test_run_ended& s) {
+                auto copy = s;
+                copy.name = copy_string(strings, s.name);
+                data.emplace<event::test_run_ended>(copy);
+            },
+            [&](const event::test_case_started& s) {
+                copy_id(s.id);
+                data.emplace<event::test_case_started>(event::test_case_started{id});
+            },
+            [&](const event::test_case_ended& s) {
+                copy_id(s.id);
+#if SNITCH_WITH_TIMINGS
+                data.emplace<event::test_case_ended>(event::test_case_ended{
+                    .id              = id,
+                    .state           = s.state,
+                    .assertion_count = s.assertion_count,
+                    .duration        = s.duration,
+                    .output          = copy_string(strings, s.output)});
+#else
+                data.emplace<event::test_case_ended>(event::test_case_ended{
+                    .id              = id,
+                    .state           = s.state,
+                    .assertion_count = s.assertion_count,
+                    .output          = copy_string(strings, s.output)});
+#endif
+            },
+            [&](const event::section_started& s) {
+                copy_id(s.id);
+                copy_sections(s.sections);
+                data.emplace<event::section_started>(event::section_started{id, sections});
+            },
+            [&](const event::section_ended& s) {
+                copy_id(s.id);
+                copy_sections(s.sections);
+#if SNITCH_WITH_TIMINGS
+                data.emplace<event::section_ended>(
+                    event::section_ended{.id = id, .sections = sections, .duration = s.duration});
+#else
+                data.emplace<event::section_ended>(
+                    event::section_ended{.id = id, .sections = sections});
+#endif
+            },
+            [&](const event::assertion_failed& s) {
+                copy_id(s.id);
+                copy_location(s.location);
+                copy_sections(s.sections);
+                copy_captures(s.captures);
+                data.emplace<event::assertion_failed>(event::assertion_failed{
+                    id, sections, captures, location,
+                    copy_string(strings, s.message), s.expected, s.allowed});
+            },
+            [&](const event::assertion_passed& s) {
+                copy_id(s.id);
+                copy_location(s.location);
+                copy_sections(s.sections);
+                copy_captures(s.captures);
+                data.emplace<event::assertion_passed>(
+                    event::assertion_passed{id, sections, captures, location});
+            },
+            [&](const event::assertion_failures_suppressed& s) {
+                copy_id(s.id);
+                copy_location(s.location);
+                data.emplace<event::assertion_failures_suppressed>(
+                    event::assertion_failures_suppressed{id, location, s.count});
+            },
+            [&](const event::test_case_skipped& s) {
+                copy_id(s.id);
+                copy_location(s.location);
+                copy_sections(s.sections);
+                copy_captures(s.captures);
+                data.emplace<event::test_case_skipped>(event::test_case_skipped{
+                    id, sections, captures, location,
+                    copy_string(strings, s.message)});
+            }},
+        e);
+}
 } // namespace snitch
 
 // Main entry point utilities.
@@ -1126,7 +2121,8 @@ using namespace std::literals;
 
 constexpr std::size_t max_arg_names = 2;
 
-enum class argument_type { optional, mandatory };
+// Repeatable arguments are optional, and may be given more than once.
+enum class argument_type { optional, mandatory, repeatable };
 
 struct expected_argument {
     small_vector<std::string_view, max_arg_names> names;
@@ -1203,7 +2199,7 @@ std::optional<cli::input> parse_arguments(
 
                 found = true;
 
-                if (expected_found[arg_index]) {
+                if (expected_found[arg_index] && e.type != argument_type::repeatable) {
                     console_print(
                         make_colored("error:", settings.with_color, color::error),
                         " duplicate command line argument '", arg, "'\n");
@@ -1360,12 +2356,67 @@ constexpr expected_arguments expected_args = {
     {{"-t", "--tags"},          {},                    "Use tags for filtering, not name"},
     {{"-v", "--verbosity"},     {"quiet|normal|high"}, "Define how much gets sent to the standard output"},
     {{"--color"},               {"always|never"},      "Enable/disable color in output"},
+    {{"--max-failures"},        {"n"},                 "Report at most n failures per check location in each test case (0: no limit)"},
+    {{"--capture-output"},      {},                    "Capture the standard output and error of test cases, and only show it for failed test cases"},
+    {{"--assertion-coverage"},  {"file"},              "Write which assertion sites were executed to a file (requires SNITCH_WITH_ASSERTION_EVENTS)"},
+    {{"-r", "--reporter"},      {"name[::out=file]"},  "Add a reporter, optionally writing to a file; may be repeated (default: console)", argument_type::repeatable},
     {{"-h", "--help"},          {},                    "Print help"},
     {{},                        {"test regex"},        "A regex to select which test cases (or tags) to run"}};
 // clang-format on
 
 constexpr bool with_color_default = SNITCH_DEFAULT_WITH_COLOR == 1;
 
+std::optional<std::size_t> parse_size(std::string_view str) noexcept {
+    std::size_t value = 0;
+    const auto  end   = str.data() + str.size();
+    const auto [ptr, ec] = std::from_chars(str.data(), end, value);
+    if (ec != std::errc{} || ptr != end) {
+        return {};
+    }
+
+    return value;
+}
+
+bool save_assertion_coverage(const snitch::registry& r, std::string_view path) noexcept {
+    if (!SNITCH_WITH_ASSERTION_EVENTS) {
+        r.print(
+            make_colored("error:", r.with_color, color::fail),
+            " assertion coverage requires SNITCH_WITH_ASSERTION_EVENTS\n");
+        return false;
+    }
+
+    // The file name must be null-terminated for fopen().
+    small_string<max_message_length> file_path;
+    if (!append(file_path, path) || file_path.available() == 0u) {
+        r.print(
+            make_colored("error:", r.with_color, color::fail),
+            " assertion coverage file name is too long\n");
+        return false;
+    }
+
+    file_path.push_back('\0');
+    std::FILE* file = std::fopen(file_path.data(), "wb");
+    if (file == nullptr) {
+        r.print(
+            make_colored("error:", r.with_color, color::fail), " could not open '", path,
+            "' for assertion coverage\n");
+        return false;
+    }
+
+    const bool success = snitch::write_assertion_coverage(file);
+    std::fclose(file);
+
+    if (!success) {
+        r.print(
+            make_colored("error:", r.with_color, color::fail),
+            " could not write assertion coverage; if there are too many assertion sites, "
+            "please increase 'SNITCH_MAX_ASSERTION_SITES' (currently ",
+            snitch::max_assertion_sites, ")\n");
+    }
+
+    return success;
+}
+
 constexpr const char* program_description = "Test runner (snitch v" SNITCH_FULL_VERSION ")";
 } // namespace
 
@@ -1413,7 +2464,7 @@ get_positional_argument(const cli::input& args, std::string_view name) noexcept
 } // namespace snitch::cli
 
 namespace snitch {
-void registry::configure(const cli::input& args) noexcept {
+bool registry::configure(const cli::input& args) noexcept {
     if (auto opt = get_option(args, "--color")) {
         if (*opt->value == "always") {
             with_color = true;
@@ -1439,6 +2490,29 @@ void registry::configure(const cli::input& args) noexcept {
                 "unknown verbosity level; please use one of quiet|normal|high\n");
         }
     }
+
+    if (auto opt = get_option(args, "--max-failures")) {
+        if (auto value = parse_size(*opt->value)) {
+            max_failures_per_site = *value;
+        } else {
+            print(
+                make_colored("warning:", with_color, color::warning),
+                "invalid maximum number of failures; please use a non-negative integer\n");
+        }
+    }
+
+    if (get_option(args, "--capture-output")) {
+        capture_output = true;
+    }
+
+    bool success = true;
+    for (const auto& arg : args.arguments) {
+        if (arg.name == "--reporter" && !select_reporter(*arg.value)) {
+            success = false;
+        }
+    }
+
+    return success;
 }
 
 bool registry::run_tests(const cli::input& args) noexcept {
@@ -1465,15 +2539,22 @@ bool registry::run_tests(const cli::input& args) noexcept {
         return true;
     }
 
+    bool success = true;
     if (auto opt = get_positional_argument(args, "test regex")) {
         if (get_option(args, "--tags")) {
-            return run_tests_with_tag(args.executable, *opt->value);
+            success = run_tests_with_tag(args.executable, *opt->value);
         } else {
-            return run_tests_matching_name(args.executable, *opt->value);
+            success = run_tests_matching_name(args.executable, *opt->value);
         }
     } else {
-        return run_all_tests(args.executable);
+        success = run_all_tests(args.executable);
+    }
+
+    if (auto opt = get_option(args, "--assertion-coverage")) {
+        success = save_assertion_coverage(*this, *opt->value) && success;
     }
+
+    return success;
 }
 } // namespace snitch
 
@@ -1488,9 +2569,15 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    snitch::tests.configure(*args);
+    if (!snitch::tests.configure(*args)) {
+        snitch::tests.clear_reporters();
+        return 1;
+    }
+
+    const bool success = snitch::tests.run_tests(*args);
+    snitch::tests.clear_reporters();
 
-    return snitch::tests.run_tests(*args) ? 0 : 1;
+    return success ? 0 : 1;
 }
 
 #endif
@@ -0,0 +1,170 @@
+#include "snitch/snitch_async.hpp"
+#include "testing.hpp"
+#include "testing_event.hpp"
+
+#include <atomic>
+#include <cstdio>
+
+#if defined(__unix__) || defined(__APPLE__)
+#    include <unistd.h>
+#endif
+
+using namespace std::literals;
+
+namespace {
+std::atomic<bool> downstream_released = false;
+
+struct blocking_reporter {
+    mock_framework& framework;
+
+    void report(const snitch::registry& r, const snitch::event::data& e) noexcept {
+        downstream_released.wait(false);
+        framework.report(r, e);
+    }
+};
+
+void print_event(const snitch::registry& r, const snitch::event::data&) noexcept {
+    r.print("event\n");
+}
+} // namespace
+
+TEST_CASE("event copy", "[async]") {
+    snitch::small_string<32> name = "test name"sv;
+
+    const snitch::test_id                       id{name.str(), "[tag]", "int"};
+    const snitch::assertion_location            location{"file.cpp", 42};
+    snitch::small_vector<snitch::section_id, 1> sections;
+    snitch::small_vector<std::string_view, 1>   captures;
+    sections.push_back({"section", "description"});
+    captures.push_back("i := 1");
+
+    snitch::event_copy copy;
+
+    SECTION("assertion failed") {
+        copy.assign(snitch::event::assertion_failed{
+            .id       = id,
+            .sections = sections,
+            .captures = captures,
+            .location = location,
+            .message  = "failure"});
+
+        // Overwrite the original data; the copy must not be affected.
+        name = "something else"sv;
+
+        auto e = deep_copy(copy.get());
+        CHECK(e.event_type == event_deep_copy::type::assertion_failed);
+        CHECK(e.test_id_name == "test name"sv);
+        CHECK(e.test_id_tags == "[tag]"sv);
+        CHECK(e.test_id_type == "int"sv);
+        CHECK(e.location_file == "file.cpp"sv);
+        CHECK(e.location_line == 42u);
+        CHECK(e.message == "failure"sv);
+        REQUIRE(e.sections.size() == 1u);
+        CHECK(e.sections[0] == "section"sv);
+        REQUIRE(e.captures.size() == 1u);
+        CHECK(e.captures[0] == "i := 1"sv);
+    }
+
+    SECTION("reuse") {
+        copy.assign(snitch::event::test_case_started{id});
+        copy.assign(snitch::event::test_run_ended{.name = "run", .run_count = 3u});
+
+        auto e = deep_copy(copy.get());
+        CHECK(e.event_type == event_deep_copy::type::test_run_ended);
+        CHECK(e.test_run_name == "run"sv);
+        CHECK(e.test_run_run_count == 3u);
+    }
+}
+
+TEST_CASE("async reporter", "[async]") {
+    mock_framework framework;
+
+    SECTION("forwards events in order") {
+        snitch::async::reporter<4> async{{framework, snitch::constant<&mock_framework::report>{}}};
+        framework.registry.report_callback = {
+            async, snitch::constant<&snitch::async::reporter<4>::report>{}};
+
+        framework.test_case.func = []() {
+            for (std::size_t i = 0; i < 6; ++i) {
+                SNITCH_FAIL_CHECK("trigger");
+            }
+        };
+
+        framework.run_test();
+        async.flush();
+
+        CHECK(framework.get_num_runs() == 1u);
+        CHECK(framework.get_num_failures() == 6u);
+        REQUIRE(framework.events.size() == 8u);
+        CHECK(framework.events[0].event_type == event_deep_copy::type::test_case_started);
+        CHECK(framework.events[7].event_type == event_deep_copy::type::test_case_ended);
+        CHECK(framework.events[7].test_id_name == "mock_test"sv);
+        CHECK(async.dropped_count() == 0u);
+    }
+
+    SECTION("drops failures when full") {
+        downstream_released = false;
+
+        blocking_reporter          blocking{framework};
+        snitch::async::reporter<2> async{
+            {blocking, snitch::constant<&blocking_reporter::report>{}},
+            snitch::async::overflow_policy::drop};
+
+        const snitch::test_id&                      id = framework.test_case.id;
+        const snitch::assertion_location            location{"file.cpp", 42};
+        snitch::small_vector<snitch::section_id, 1> sections;
+        snitch::small_vector<std::string_view, 1>   captures;
+
+        const snitch::event::assertion_failed failure{
+            .id = id, .sections = sections, .captures = captures, .location = location};
+
+        async.report(framework.registry, snitch::event::test_case_started{id});
+        async.report(framework.registry, failure);
+        async.report(framework.registry, failure);
+
+        CHECK(async.dropped_count() == 1u);
+
+        downstream_released = true;
+        downstream_released.notify_all();
+        async.flush();
+
+        CHECK(framework.events.size() == 2u);
+        CHECK(framework.get_num_failures() == 1u);
+    }
+
+    SECTION("prints to the output of the reporter") {
+        output_file output;
+        REQUIRE(output.file != nullptr);
+
+        snitch::async::reporter<4> async{&print_event};
+
+        snitch::impl::set_current_output(output.file);
+        async.report(framework.registry, snitch::event::test_case_started{framework.test_case.id});
+        snitch::impl::set_current_output(nullptr);
+        async.flush();
+
+        CHECK(output.read() == "event\n"sv);
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    SECTION("flush writes the printed output") {
+        output_file output;
+        REQUIRE(output.file != nullptr);
+
+        snitch::impl::stdout_flush();
+        const int saved = ::dup(STDOUT_FILENO);
+        ::dup2(::fileno(output.file), STDOUT_FILENO);
+
+        // The registry prints to the standard output, buffered on the reporter thread.
+        snitch::async::reporter<4> async{&print_event};
+        async.report(framework.registry, snitch::event::test_case_started{framework.test_case.id});
+        async.flush();
+        const std::string_view printed = output.read();
+
+        ::dup2(saved, STDOUT_FILENO);
+        ::close(saved);
+
+        CHECK(printed == "event\n"sv);
+    }
+#endif
+}
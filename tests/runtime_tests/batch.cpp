@@ -0,0 +1,72 @@
+#include "snitch/snitch_batch.hpp"
+#include "testing.hpp"
+#include "testing_event.hpp"
+
+using namespace std::literals;
+
+namespace {
+struct batch_recorder {
+    mock_framework&                      framework;
+    snitch::small_vector<std::size_t, 8> sizes = {};
+
+    void report(const snitch::registry& r, snitch::batch::events events) noexcept {
+        sizes.push_back(events.size());
+        for (const auto& e : events) {
+            framework.report(r, e.get());
+        }
+    }
+};
+} // namespace
+
+TEST_CASE("batch reporter", "[batch]") {
+    mock_framework framework;
+    mock_framework recorder;
+    batch_recorder batches{recorder};
+
+    snitch::batch::reporter<4> batch{{batches, snitch::constant<&batch_recorder::report>{}}};
+    framework.registry.report_callback = {
+        batch, snitch::constant<&snitch::batch::reporter<4>::report>{}};
+
+    SECTION("one batch per test case") {
+        framework.test_case.func = []() { SNITCH_FAIL_CHECK("no"); };
+        framework.run_test();
+        framework.run_test();
+
+        REQUIRE(batches.sizes.size() == 2u);
+        CHECK(batches.sizes[0] == 3u);
+        CHECK(batches.sizes[1] == 3u);
+        CHECK(recorder.get_num_runs() == 2u);
+        CHECK(recorder.get_num_failures() == 2u);
+
+        auto failure = recorder.get_failure_event(1u);
+        REQUIRE(failure.has_value());
+        CHECK(failure->test_id_name == "mock_test"sv);
+        CHECK(failure->message == "no"sv);
+    }
+
+    SECTION("full batch") {
+        framework.test_case.func = []() {
+            for (std::size_t i = 0; i < 5u; ++i) {
+                SNITCH_FAIL_CHECK("no");
+            }
+        };
+        framework.run_test();
+
+        REQUIRE(batches.sizes.size() == 2u);
+        CHECK(batches.sizes[0] == 4u);
+        CHECK(batches.sizes[1] == 3u);
+        CHECK(recorder.get_num_failures() == 5u);
+    }
+
+    SECTION("manual flush") {
+        batch.report(framework.registry, snitch::event::test_run_started{"run"});
+        CHECK(batches.sizes.empty());
+
+        batch.flush();
+        REQUIRE(batches.sizes.size() == 1u);
+        CHECK(batches.sizes[0] == 1u);
+
+        batch.flush();
+        CHECK(batches.sizes.size() == 1u);
+    }
+}
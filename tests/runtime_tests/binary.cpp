@@ -0,0 +1,190 @@
+#include "snitch/snitch_binary.hpp"
+#include "testing.hpp"
+#include "testing_event.hpp"
+
+#include <cstdio>
+#include <string>
+
+using namespace std::literals;
+
+TEST_CASE("binary stream", "[binary]") {
+    output_file tmp;
+    REQUIRE(tmp.file != nullptr);
+
+    mock_framework recorder;
+    mock_framework replayer;
+
+    SECTION("round trip") {
+        snitch::binary::writer writer{tmp.file};
+        recorder.registry.report_callback = {
+            writer, snitch::constant<&snitch::binary::writer::report>{}};
+
+        recorder.test_case.func = []() {
+            SNITCH_CAPTURE(1);
+            SNITCH_SECTION("section") {
+                SNITCH_FAIL_CHECK("trigger");
+            }
+            SNITCH_FAIL_CHECK("trigger again");
+            SNITCH_SKIP("skipped");
+        };
+
+        recorder.run_test();
+        recorder.run_test();
+
+        std::rewind(tmp.file);
+        snitch::binary::reader reader{tmp.file};
+
+        CHECK(reader.replay(
+            replayer.registry, {replayer, snitch::constant<&mock_framework::report>{}}));
+
+        CHECK(replayer.get_num_runs() == 2u);
+        CHECK(replayer.get_num_failures() == 4u);
+        CHECK(replayer.get_num_skips() == 2u);
+
+        auto failure = replayer.get_failure_event(0u);
+        REQUIRE(failure.has_value());
+        CHECK(failure->test_id_name == "mock_test"sv);
+        CHECK(failure->test_id_tags == "[mock_tag]"sv);
+        CHECK(failure->test_id_type == "mock_type"sv);
+        CHECK(failure->message == "trigger"sv);
+        CHECK(failure->location_line != 0u);
+        REQUIRE(failure->sections.size() == 1u);
+        CHECK(failure->sections[0] == "section"sv);
+        REQUIRE(failure->captures.size() == 1u);
+        CHECK(failure->captures[0] == "1 := 1"sv);
+
+        auto skip = replayer.get_skip_event();
+        REQUIRE(skip.has_value());
+        CHECK(skip->message == "skipped"sv);
+
+        REQUIRE(replayer.events.size() > 2u);
+        CHECK(replayer.events[1].event_type == event_deep_copy::type::section_started);
+        CHECK(replayer.events[3].event_type == event_deep_copy::type::section_ended);
+        REQUIRE(replayer.events[3].sections.size() == 1u);
+        CHECK(replayer.events[3].sections[0] == "section"sv);
+    }
+
+    SECTION("passed assertion") {
+        snitch::binary::writer writer{tmp.file};
+
+        const snitch::assertion_location                  location{"file.cpp", 12u};
+        const snitch::small_vector<snitch::section_id, 1> sections = {};
+        const snitch::small_vector<std::string_view, 1>   captures = {};
+        writer.report(
+            recorder.registry, snitch::event::assertion_passed{
+                                   recorder.test_case.id, sections.span(), captures.span(),
+                                   location});
+
+        std::rewind(tmp.file);
+        snitch::binary::reader reader{tmp.file};
+
+        replayer.record_passed = true;
+        CHECK(reader.replay(
+            replayer.registry, {replayer, snitch::constant<&mock_framework::report>{}}));
+
+        auto passed = replayer.get_passed_event();
+        REQUIRE(passed.has_value());
+        CHECK(passed->test_id_name == "mock_test"sv);
+        CHECK(passed->location_file == "file.cpp"sv);
+        CHECK(passed->location_line == 12u);
+    }
+
+    SECTION("more sections and captures than a record holds") {
+        snitch::binary::writer writer{tmp.file};
+
+        const std::string long_string(100u, 'a');
+        snitch::small_vector<snitch::section_id, 100> sections;
+        snitch::small_vector<std::string_view, 100>   captures;
+        for (std::size_t i = 0; i < 100u; ++i) {
+            sections.push_back({long_string, long_string});
+            captures.push_back(long_string);
+        }
+
+        const auto&                      all_sections = sections;
+        const auto&                      all_captures = captures;
+        const snitch::assertion_location location{"file.cpp", 12u};
+        writer.report(
+            recorder.registry, snitch::event::assertion_failed{
+                                   .id       = recorder.test_case.id,
+                                   .sections = all_sections.span(),
+                                   .captures = all_captures.span(),
+                                   .location = location,
+                                   .message  = "trigger"});
+
+        std::rewind(tmp.file);
+        snitch::binary::reader reader{tmp.file};
+
+        CHECK(reader.replay(
+            replayer.registry, {replayer, snitch::constant<&mock_framework::report>{}}));
+
+        auto failure = replayer.get_failure_event(0u);
+        REQUIRE(failure.has_value());
+        CHECK(failure->sections.size() == snitch::max_nested_sections);
+        CHECK(failure->captures.size() == snitch::max_captures);
+        CHECK(failure->location_line == 12u);
+    }
+
+#if defined(__linux__)
+    SECTION("write error") {
+        std::FILE* full = std::fopen("/dev/full", "w");
+        REQUIRE(full != nullptr);
+        recorder.setup_print();
+
+        {
+            snitch::binary::writer writer{full};
+            writer.report(recorder.registry, snitch::event::test_run_started{.name = "run"});
+            writer.report(recorder.registry, snitch::event::test_run_ended{.name = "run"});
+            writer.report(recorder.registry, snitch::event::test_run_ended{.name = "run"});
+
+            CHECK(writer.failed());
+        }
+
+        std::fclose(full);
+        CHECK(
+            recorder.messages ==
+            "error: could not write the binary event stream; no more events are written\n"sv);
+    }
+#endif
+
+    SECTION("strings are written once") {
+        snitch::binary::writer writer{tmp.file};
+        recorder.registry.report_callback = {
+            writer, snitch::constant<&snitch::binary::writer::report>{}};
+
+        recorder.test_case.func = []() { SNITCH_FAIL_CHECK("trigger"); };
+
+        recorder.run_test();
+        const long first_size = tmp.size();
+        recorder.run_test();
+        const long second_size = tmp.size() - first_size;
+
+        // The second run only refers to the test ID and file name already written.
+        CHECK(second_size < first_size - 8);
+    }
+
+    SECTION("invalid stream") {
+        std::fputs("not a snitch stream", tmp.file);
+        std::rewind(tmp.file);
+        snitch::binary::reader reader{tmp.file};
+
+        CHECK(!reader.replay(
+            replayer.registry, {replayer, snitch::constant<&mock_framework::report>{}}));
+        CHECK(replayer.events.empty());
+    }
+
+    SECTION("incomplete record") {
+        // A test_run_started record with its name ("a"), but not its test count.
+        constexpr std::string_view record = "\x01\x03\x00\x01"
+                                            "a"sv;
+        std::fwrite(
+            snitch::binary::stream_header.data(), 1u, snitch::binary::stream_header.size(),
+            tmp.file);
+        std::fwrite(record.data(), 1u, record.size(), tmp.file);
+        std::rewind(tmp.file);
+        snitch::binary::reader reader{tmp.file};
+
+        CHECK(!reader.replay(
+            replayer.registry, {replayer, snitch::constant<&mock_framework::report>{}}));
+        CHECK(replayer.events.empty());
+    }
+}
@@ -1,6 +1,8 @@
 #include "testing.hpp"
 #include "testing_event.hpp"
 
+#include <cstddef>
+#include <iterator>
 #include <string>
 
 using namespace std::literals;
@@ -326,4 +328,170 @@ TEST_CASE("info", "[test macros]") {
     }
 }
 
+TEST_CASE("capture storage", "[test macros]") {
+    mock_framework framework;
+
+    std::size_t capture_count = 0u;
+    std::string last_capture_copy;
+
+    framework.registry.report_callback = [&](const snitch::registry&,
+                                             const snitch::event::data& e) noexcept {
+        if (const auto* f = std::get_if<snitch::event::assertion_failed>(&e)) {
+            capture_count = f->captures.size();
+            last_capture_copy.assign(f->captures.empty() ? ""sv : f->captures.back());
+        }
+    };
+
+    SECTION("more captures than an event copy") {
+        framework.test_case.func = []() {
+            int a = 1, b = 2, c = 3, d = 4, e = 5, f = 6;
+            SNITCH_CAPTURE(a, b, c, d, e, f);
+            SNITCH_INFO("first");
+            SNITCH_INFO("second");
+            SNITCH_CAPTURE(a + b, c + d);
+            SNITCH_FAIL("trigger");
+        };
+
+        framework.run_test();
+        CHECK(capture_count == snitch::max_captures + 2u);
+        CHECK(last_capture_copy == "c + d := 7");
+    }
+
+    SECTION("long capture") {
+        framework.test_case.func = []() {
+            std::string s(1000u, 'a');
+            SNITCH_CAPTURE(s);
+            SNITCH_FAIL("trigger");
+        };
+
+        framework.run_test();
+        CHECK(capture_count == 1u);
+        CHECK(last_capture_copy.size() == snitch::max_capture_length);
+        CHECK(last_capture_copy.starts_with("s := aaa"sv));
+        CHECK(last_capture_copy.ends_with("..."sv));
+    }
+
+    SECTION("long capture followed by a section and a capture") {
+        framework.test_case.func = []() {
+            std::string s(snitch::max_test_arena_size, 'a');
+            SNITCH_INFO(s);
+            SNITCH_SECTION("section") {
+                int i = 1;
+                SNITCH_CAPTURE(i);
+                SNITCH_FAIL("trigger");
+            }
+        };
+
+        framework.run_test();
+        CHECK(capture_count == 2u);
+        CHECK(last_capture_copy == "i := 1");
+    }
+
+    SECTION("released at scope exit") {
+        framework.test_case.func = []() {
+            for (int i = 0; i < 1000; ++i) {
+                SNITCH_CAPTURE(i);
+                SNITCH_INFO("iteration ", i);
+            }
+
+            SNITCH_FAIL("trigger");
+        };
+
+        framework.run_test();
+        CHECK(capture_count == 0u);
+    }
+}
+
+TEST_CASE("test arena", "[test macros]") {
+    alignas(std::max_align_t) char buffer[512];
+    snitch::impl::test_arena arena(std::begin(buffer), std::end(buffer));
+
+    SECTION("empty") {
+        const auto lists = arena.list();
+        CHECK(lists.sections.empty());
+        CHECK(lists.captures.empty());
+        CHECK(arena.level_count() == 0u);
+    }
+
+    SECTION("sections and captures in order") {
+        REQUIRE(arena.add_section({"section 1", ""}));
+        auto capture = arena.add_capture();
+        REQUIRE(capture.has_value());
+        append_or_truncate(*capture, "i := ", 1);
+        REQUIRE(arena.add_section({"section 2", "description"}));
+        REQUIRE(arena.add_level());
+        REQUIRE(arena.add_level());
+        arena.level(1).max_section_id = 2u;
+
+        const auto lists = arena.list();
+        REQUIRE(lists.sections.size() == 2u);
+        CHECK(lists.sections[0].name == "section 1"sv);
+        CHECK(lists.sections[1].name == "section 2"sv);
+        CHECK(lists.sections[1].description == "description"sv);
+        REQUIRE(lists.captures.size() == 1u);
+        CHECK(lists.captures[0] == "i := 1"sv);
+        CHECK(arena.level_count() == 2u);
+        CHECK(arena.level(0).max_section_id == 0u);
+        CHECK(arena.level(1).max_section_id == 2u);
+
+        arena.remove_last();
+        arena.remove_level();
+        CHECK(arena.list().sections.size() == 1u);
+        CHECK(arena.list().captures.size() == 1u);
+        CHECK(arena.level_count() == 1u);
+
+        arena.clear();
+        arena.clear_levels();
+        CHECK(arena.list().sections.empty());
+        CHECK(arena.list().captures.empty());
+        CHECK(arena.level_count() == 0u);
+    }
+
+    SECTION("full") {
+        std::size_t count = 0u;
+        while (arena.add_section({"section", ""})) {
+            ++count;
+        }
+
+        while (arena.add_level()) {
+        }
+
+        CHECK(count > 0u);
+        CHECK(!arena.add_section({"section", ""}));
+        CHECK(arena.list().sections.size() == count);
+
+        arena.remove_last();
+        CHECK(arena.add_section({"section", ""}));
+    }
+
+    SECTION("long capture truncated") {
+        auto capture = arena.add_capture();
+        REQUIRE(capture.has_value());
+        append_or_truncate(*capture, std::string(1000u, 'a'));
+
+        const auto lists = arena.list();
+        REQUIRE(lists.captures.size() == 1u);
+        CHECK(lists.captures[0].size() <= snitch::max_capture_length);
+        CHECK(lists.captures[0].size() < sizeof(buffer));
+        CHECK(lists.captures[0].ends_with("..."sv));
+        CHECK(arena.add_section({"section", ""}));
+    }
+
+    SECTION("nested") {
+        REQUIRE(arena.add_section({"outer", ""}));
+        REQUIRE(arena.add_level());
+
+        snitch::impl::test_arena nested = arena.make_nested();
+        REQUIRE(nested.add_section({"inner", ""}));
+        REQUIRE(nested.add_level());
+        nested.level(0).max_section_id = 5u;
+
+        CHECK(nested.list().sections.size() == 1u);
+        CHECK(nested.list().sections[0].name == "inner"sv);
+        CHECK(arena.list().sections.size() == 1u);
+        CHECK(arena.list().sections[0].name == "outer"sv);
+        CHECK(arena.level(0).max_section_id == 0u);
+    }
+}
+
 SNITCH_WARNING_POP
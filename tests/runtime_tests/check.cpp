@@ -2,6 +2,7 @@
 #include "testing_event.hpp"
 
 #include <algorithm>
+#include <vector>
 
 using namespace std::literals;
 
@@ -77,16 +78,25 @@ struct event_catcher {
     snitch::impl::test_state mock_test{.reg = mock_registry, .test = mock_case};
 
     std::optional<event_deep_copy> last_event;
+    std::size_t                    passed = 0u;
 
     event_catcher() {
         mock_registry.report_callback = {*this, snitch::constant<&event_catcher::report>{}};
     }
 
     void report(const snitch::registry&, const snitch::event::data& e) noexcept {
+        if (std::holds_alternative<snitch::event::assertion_passed>(e)) {
+            ++passed;
+            return;
+        }
+
         last_event.emplace(deep_copy(e));
     }
 };
 
+// Passed assertions are only reported with SNITCH_WITH_ASSERTION_EVENTS.
+constexpr std::size_t passed_events = SNITCH_WITH_ASSERTION_EVENTS ? 1u : 0u;
+
 struct test_override {
     snitch::impl::test_state* previous;
 
@@ -120,12 +130,14 @@ struct long_matcher_always_fails {
 #define CHECK_EXPR_SUCCESS(CATCHER)                                                                \
     do {                                                                                           \
         CHECK((CATCHER).mock_test.asserts == 1u);                                                  \
+        CHECK((CATCHER).passed == passed_events);                                                  \
         CHECK(!(CATCHER).last_event.has_value());                                                  \
     } while (0)
 
 #define CHECK_EXPR_FAILURE(CATCHER, FAILURE_LINE, MESSAGE)                                         \
     do {                                                                                           \
         CHECK((CATCHER).mock_test.asserts == 1u);                                                  \
+        CHECK((CATCHER).passed == 0u);                                                             \
         REQUIRE((CATCHER).last_event.has_value());                                                 \
         const auto& event = (CATCHER).last_event.value();                                          \
         CHECK(event.event_type == event_deep_copy::type::assertion_failed);                        \
@@ -907,11 +919,11 @@ TEST_CASE("check misc", "[test macros]") {
         {
             test_override override(catcher);
             // clang-format off
-            SNITCH_CHECK(string1.str() == string2.str()); failure_line = __LINE__;
+            SNITCH_CHECK(string1.str() > string2.str()); failure_line = __LINE__;
             // clang-format on
         }
 
-        CHECK_EXPR_FAILURE(catcher, failure_line, "CHECK(string1.str() == string2.str())"sv);
+        CHECK_EXPR_FAILURE(catcher, failure_line, "CHECK(string1.str() > string2.str())"sv);
     }
 
     SECTION("out of space binary rhs") {
@@ -929,11 +941,11 @@ TEST_CASE("check misc", "[test macros]") {
         {
             test_override override(catcher);
             // clang-format off
-            SNITCH_CHECK(string1.str() == string2.str()); failure_line = __LINE__;
+            SNITCH_CHECK(string1.str() > string2.str()); failure_line = __LINE__;
             // clang-format on
         }
 
-        CHECK_EXPR_FAILURE(catcher, failure_line, "CHECK(string1.str() == string2.str())"sv);
+        CHECK_EXPR_FAILURE(catcher, failure_line, "CHECK(string1.str() > string2.str())"sv);
     }
 
     SECTION("out of space binary op") {
@@ -951,11 +963,27 @@ TEST_CASE("check misc", "[test macros]") {
         {
             test_override override(catcher);
             // clang-format off
-            SNITCH_CHECK(string1.str() == string2.str()); failure_line = __LINE__;
+            SNITCH_CHECK(string1.str() > string2.str()); failure_line = __LINE__;
             // clang-format on
         }
 
-        CHECK_EXPR_FAILURE(catcher, failure_line, "CHECK(string1.str() == string2.str())"sv);
+        CHECK_EXPR_FAILURE(catcher, failure_line, "CHECK(string1.str() > string2.str())"sv);
+    }
+
+    SECTION("diff range") {
+        const std::vector<int> values1      = {1, 2, 3};
+        const std::vector<int> values2      = {1, 5, 3};
+        std::size_t            failure_line = 0u;
+
+        {
+            test_override override(catcher);
+            // clang-format off
+            SNITCH_CHECK(values1 == values2); failure_line = __LINE__;
+            // clang-format on
+        }
+
+        CHECK_EXPR_FAILURE(
+            catcher, failure_line, "CHECK(values1 == values2), got {1, 2, 3} != {1, 5, 3}"sv);
     }
 
     SECTION("non copiable non movable pass") {
@@ -1056,3 +1084,239 @@ TEST_CASE("check misc", "[test macros]") {
             "CHECK(\"hello\"sv == snitch::matchers::contains_substring{\"foo\"}), got could not find 'foo' in 'hello'"sv);
     }
 }
+
+TEST_CASE("check diff", "[test macros]") {
+    snitch::impl::expression expr;
+
+    SECTION("string") {
+        constexpr std::string_view long_text =
+            "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor "
+            "incididunt ut labore et dolore magna aliqua. Ut enim ad minim veniam, quis nostrud "
+            "exercitation ullamco laboris nisi ut aliquip ex ea commodo consequat."sv;
+
+        snitch::small_string<256> string = long_text;
+        string[100]                      = 'X';
+
+        CHECK(snitch::impl::append_diff(expr, long_text, " != "sv, string));
+        CHECK(
+            expr.actual == "...idunt ut labore et dolore magna a... != "
+                           "...idunt ut labore Xt dolore magna a... "
+                           "(first difference at index 100)"sv);
+    }
+
+    SECTION("string insertion") {
+        snitch::small_string<256> string1;
+        snitch::small_string<256> string2;
+        string1.resize(200u);
+        string2.resize(203u);
+        std::fill(string1.begin(), string1.end(), 'a');
+        std::fill(string2.begin(), string2.end(), 'a');
+        string2[150] = 'b';
+        string2[151] = 'c';
+        string2[152] = 'd';
+
+        CHECK(snitch::impl::append_diff(expr, string1, " != "sv, string2));
+        CHECK(
+            expr.actual == "...aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa... != "
+                           "...aaaaaaaaaaaaaaaabcdaaaaaaaaaaaaaaaa... "
+                           "(first difference at index 150)"sv);
+    }
+
+    SECTION("string different sizes") {
+        snitch::small_string<256> string1;
+        string1.resize(200u);
+        std::fill(string1.begin(), string1.end(), 'a');
+        snitch::small_string<256> string2 = string1;
+        string2.resize(180u);
+
+        CHECK(snitch::impl::append_diff(expr, string1, " != "sv, string2));
+        CHECK(
+            expr.actual == "...aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa != ...aaaaaaaaaaaaaaaa "
+                           "(first difference at index 180)"sv);
+    }
+
+    SECTION("string all different") {
+        snitch::small_string<256> string1;
+        snitch::small_string<256> string2;
+        string1.resize(200u);
+        string2.resize(200u);
+        std::fill(string1.begin(), string1.end(), '0');
+        std::fill(string2.begin(), string2.end(), '1');
+
+        CHECK(snitch::impl::append_diff(expr, string1, " != "sv, string2));
+        CHECK(expr.actual.str().starts_with("000"sv));
+        CHECK(expr.actual.str().ends_with("111... (first difference at index 0)"sv));
+        CHECK(expr.actual.size() <= expr.actual.capacity());
+    }
+
+    SECTION("string equal") {
+        snitch::small_string<256> string;
+        string.resize(200u);
+        std::fill(string.begin(), string.end(), 'a');
+
+        CHECK(!snitch::impl::append_diff(expr, string, " == "sv, string));
+    }
+
+    SECTION("range") {
+        std::vector<int> values1(100u);
+        for (std::size_t i = 0; i < values1.size(); ++i) {
+            values1[i] = static_cast<int>(i % 10u);
+        }
+
+        std::vector<int> values2 = values1;
+        values2[60]              = -1;
+
+        CHECK(snitch::impl::append_diff(expr, values1, " != "sv, values2));
+        CHECK(
+            expr.actual == "{..., 6, 7, 8, 9, 0, 1, 2, 3, 4, ...} != "
+                           "{..., 6, 7, 8, 9, -1, 1, 2, 3, 4, ...} "
+                           "(first difference at index 60)"sv);
+    }
+}
+
+TEST_CASE("check that", "[test macros]") {
+    event_catcher catcher;
+
+    SECTION("pass") {
+        {
+            test_override override(catcher);
+            SNITCH_CHECK_THAT("info: hello"sv, snitch::matchers::contains_substring{"hello"});
+        }
+
+        CHECK_EXPR_SUCCESS(catcher);
+    }
+
+    SECTION("fail") {
+        std::size_t failure_line = 0u;
+
+        {
+            test_override override(catcher);
+            // clang-format off
+            SNITCH_CHECK_THAT("info: hello"sv, snitch::matchers::contains_substring{"bye"}); failure_line = __LINE__;
+            // clang-format on
+        }
+
+        CHECK_EXPR_FAILURE(catcher, failure_line, "could not find 'bye' in 'info: hello'"sv);
+    }
+
+    SECTION("require fail") {
+        const int   values[]     = {1, 2, 3};
+        const int   expected[]   = {1, 5, 3};
+        std::size_t failure_line = 0u;
+
+        {
+            test_override override(catcher);
+            // clang-format off
+            SNITCH_REQUIRE_THAT(values, snitch::matchers::equals_range{expected}); failure_line = __LINE__;
+            // clang-format on
+        }
+
+        CHECK_EXPR_FAILURE(
+            catcher, failure_line,
+            "1 of 3 elements differ, at indices 1; max error 3 at index 1 (got 2, expected 5)"sv);
+    }
+}
+
+namespace {
+constexpr int twice(int i) {
+    return 2 * i;
+}
+
+constexpr int evaluation_context() {
+    return std::is_constant_evaluated() ? 1 : 2;
+}
+} // namespace
+
+TEST_CASE("check constexpr", "[test macros]") {
+    event_catcher catcher;
+
+    SECTION("static require") {
+        {
+            test_override override(catcher);
+            SNITCH_STATIC_REQUIRE(twice(2) == 4);
+        }
+
+        CHECK_EXPR_SUCCESS(catcher);
+    }
+
+    SECTION("static check pass") {
+        {
+            test_override override(catcher);
+            SNITCH_STATIC_CHECK(twice(2) == 4);
+        }
+
+        CHECK_EXPR_SUCCESS(catcher);
+    }
+
+    SECTION("static check fail") {
+        constexpr int value       = 3;
+        std::size_t  failure_line = 0u;
+
+        {
+            test_override override(catcher);
+            // clang-format off
+            SNITCH_STATIC_CHECK(twice(value) == 5); failure_line = __LINE__;
+            // clang-format on
+        }
+
+        CHECK_EXPR_FAILURE(catcher, failure_line, "STATIC_CHECK(twice(value) == 5), got 6 != 5"sv);
+    }
+
+    SECTION("constexpr check pass") {
+        {
+            test_override override(catcher);
+            SNITCH_CONSTEXPR_CHECK(twice(2) == 4);
+        }
+
+        CHECK(catcher.mock_test.asserts == 2u);
+        CHECK(catcher.passed == 2u * passed_events);
+        CHECK(!catcher.last_event.has_value());
+    }
+
+    SECTION("constexpr check fail at run time only") {
+        std::size_t failure_line = 0u;
+
+        {
+            test_override override(catcher);
+            // clang-format off
+            SNITCH_CONSTEXPR_CHECK(evaluation_context() == 1); failure_line = __LINE__;
+            // clang-format on
+        }
+
+        CHECK(catcher.mock_test.asserts == 2u);
+        CHECK(catcher.passed == passed_events);
+        REQUIRE(catcher.last_event.has_value());
+        const auto& event = catcher.last_event.value();
+        CHECK_EVENT_LOCATION(event, __FILE__, failure_line);
+        CHECK(event.message == "CONSTEXPR_CHECK[run-time](evaluation_context() == 1), got 2 != 1"sv);
+    }
+
+    SECTION("constexpr check fail at compile time only") {
+        std::size_t failure_line = 0u;
+
+        {
+            test_override override(catcher);
+            // clang-format off
+            SNITCH_CONSTEXPR_CHECK(evaluation_context() == 2); failure_line = __LINE__;
+            // clang-format on
+        }
+
+        CHECK(catcher.mock_test.asserts == 2u);
+        CHECK(catcher.passed == passed_events);
+        REQUIRE(catcher.last_event.has_value());
+        const auto& event = catcher.last_event.value();
+        CHECK_EVENT_LOCATION(event, __FILE__, failure_line);
+        CHECK(
+            event.message ==
+            "CONSTEXPR_CHECK[compile-time](evaluation_context() == 2), got 1 != 2"sv);
+    }
+}
+
+SNITCH_CONSTEXPR_TEST_CASE("constexpr test case", "[test macros]") {
+    int value = 1;
+    SNITCH_REQUIRE(twice(value) == 2);
+    SNITCH_CHECK(evaluation_context() == 1);
+    SNITCH_CHECK_FALSE(value == 0);
+    SNITCH_STATIC_REQUIRE(twice(1) == 2);
+    SNITCH_STATIC_CHECK(twice(1) == 2);
+}
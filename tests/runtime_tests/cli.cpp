@@ -127,6 +127,21 @@ TEST_CASE("parse arguments verbosity (no value)", "[cli]") {
             "missing value '<quiet|normal|high>' for command line argument '--verbosity'"));
 }
 
+TEST_CASE("parse arguments reporter (repeated)", "[cli]") {
+    console_output_catcher console;
+
+    const arg_vector args = {"test", "--reporter", "console", "-r", "junit::out=results.xml"};
+    auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+
+    REQUIRE(input.has_value());
+    REQUIRE(input->arguments.size() == 2u);
+    CHECK(input->arguments[0].name == "--reporter"sv);
+    CHECK(input->arguments[0].value == "console"sv);
+    CHECK(input->arguments[1].name == "--reporter"sv);
+    CHECK(input->arguments[1].value == "junit::out=results.xml"sv);
+    CHECK(console.messages.empty());
+}
+
 TEST_CASE("parse arguments unknown", "[cli]") {
     console_output_catcher console;
 
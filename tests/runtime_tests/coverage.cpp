@@ -0,0 +1,135 @@
+#include "testing.hpp"
+#include "testing_event.hpp"
+
+#include <cstdio>
+
+using namespace std::literals;
+
+#if SNITCH_WITH_ASSERTION_EVENTS
+namespace {
+struct coverage_reader : output_file {
+    bool good = true;
+
+    std::size_t read_varint() {
+        std::size_t value = 0u;
+        for (std::size_t shift = 0u; good; shift += 7u) {
+            const int byte = std::fgetc(file);
+            good           = byte != EOF;
+            value |= static_cast<std::size_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                break;
+            }
+        }
+
+        return value;
+    }
+};
+
+struct site_coverage {
+    bool found    = false;
+    bool executed = false;
+};
+
+// Reads the coverage file, and finds the site at the given line of this file.
+site_coverage find_site(coverage_reader& reader, std::size_t line) {
+    std::rewind(reader.file);
+
+    char magic[5] = {};
+    reader.good   = std::fread(magic, 1u, 5u, reader.file) == 5u &&
+                  std::string_view{magic, 5u} == "SNCV\x01"sv;
+
+    snitch::small_vector<bool, 1024> is_this_file;
+    const std::size_t                file_count = reader.read_varint();
+    for (std::size_t i = 0; i < file_count && reader.good; ++i) {
+        snitch::small_string<1024> name;
+        name.resize(reader.read_varint());
+        reader.good = reader.good && std::fread(name.data(), 1u, name.size(), reader.file) ==
+                                         name.size();
+        is_this_file.push_back(name.str() == __FILE__);
+    }
+
+    const std::size_t site_count = reader.read_varint();
+    std::size_t       index      = site_count;
+    for (std::size_t i = 0; i < site_count && reader.good; ++i) {
+        const std::size_t f = reader.read_varint();
+        const std::size_t l = reader.read_varint();
+        if (f < is_this_file.size() && is_this_file[f] && l == line) {
+            index = i;
+        }
+    }
+
+    site_coverage site;
+    for (std::size_t i = 0; i < (site_count + 7u) / 8u && reader.good; ++i) {
+        const int byte = std::fgetc(reader.file);
+        reader.good    = byte != EOF;
+        if (index / 8u == i) {
+            site.found    = true;
+            site.executed = (byte & (1 << (index % 8u))) != 0;
+        }
+    }
+
+    return site;
+}
+
+std::size_t executed_line = 0u;
+std::size_t never_line    = 0u;
+} // namespace
+
+TEST_CASE("assertion passed events", "[coverage]") {
+    mock_framework framework;
+    framework.setup_reporter();
+    framework.record_passed = true;
+
+    framework.test_case.func = []() {
+        SNITCH_CHECK(1 == 2);
+        SNITCH_SECTION("section") {
+            SNITCH_CHECK(1 == 1);
+        }
+        SNITCH_REQUIRE_THAT("abc"sv, snitch::matchers::contains_substring{"b"});
+    };
+
+    framework.run_test();
+
+    CHECK(framework.get_num_failures() == 1u);
+    CHECK(framework.get_num_passed() == 2u);
+
+    auto passed = framework.get_passed_event();
+    REQUIRE(passed.has_value());
+    CHECK_EVENT_TEST_ID(passed.value(), framework.test_case.id);
+    CHECK(passed->location_file == std::string_view(__FILE__));
+    REQUIRE(passed->sections.size() == 1u);
+    CHECK(passed->sections[0] == "section"sv);
+}
+
+TEST_CASE("assertion coverage", "[coverage]") {
+    coverage_reader reader;
+    REQUIRE(reader.file != nullptr);
+
+    mock_framework framework;
+    framework.test_case.func = []() {
+        // clang-format off
+        SNITCH_CHECK(true); executed_line = __LINE__;
+        [[maybe_unused]] auto never = []() { SNITCH_CHECK(false); }; never_line = __LINE__;
+        // clang-format on
+    };
+
+    framework.run_test();
+    REQUIRE(snitch::write_assertion_coverage(reader.file));
+
+    const site_coverage executed = find_site(reader, executed_line);
+    CHECK(reader.good);
+    CHECK(executed.found);
+    CHECK(executed.executed);
+
+    const site_coverage not_executed = find_site(reader, never_line);
+    CHECK(reader.good);
+    CHECK(not_executed.found);
+    CHECK(!not_executed.executed);
+}
+#else
+TEST_CASE("assertion coverage", "[coverage]") {
+    output_file output;
+    REQUIRE(output.file != nullptr);
+    CHECK(!snitch::write_assertion_coverage(output.file));
+}
+#endif
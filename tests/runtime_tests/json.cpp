@@ -0,0 +1,119 @@
+#include "snitch/snitch_json.hpp"
+#include "testing.hpp"
+#include "testing_event.hpp"
+
+#include <cstdio>
+
+using namespace std::literals;
+
+TEST_CASE("json strings", "[json]") {
+    output_file output;
+    REQUIRE(output.file != nullptr);
+
+    SECTION("escaping") {
+        snitch::json::write_string(output.file, "a\"b\\c\nd\te\x01" "f\x1f"sv);
+        CHECK(output.read() == R"("a\"b\\c\nd\te\u0001f\u001f")"sv);
+    }
+
+    SECTION("long string") {
+        // Long enough to be escaped in several chunks.
+        snitch::small_string<1024> string;
+        for (std::size_t i = 0; i < 300; ++i) {
+            append_or_truncate(string, "a\"b");
+        }
+
+        snitch::json::write_string(output.file, string);
+        const std::string_view json = output.read();
+        CHECK(json.size() == 300u * 4u + 2u);
+        CHECK(json.starts_with(R"("a\"ba\"b)"sv));
+        CHECK(json.ends_with(R"(a\"ba\"b")"sv));
+    }
+}
+
+TEST_CASE("json reporter", "[json]") {
+    output_file output;
+    REQUIRE(output.file != nullptr);
+
+    mock_framework         framework;
+    snitch::json::reporter json{output.file};
+    framework.registry.report_callback = {
+        json, snitch::constant<&snitch::json::reporter::report>{}};
+
+    SECTION("test run") {
+        framework.registry.report_callback(
+            framework.registry, snitch::event::test_run_started{"run \"1\"", 3u});
+
+        CHECK(
+            output.line(0) ==
+            R"({"event":"test_run_started","name":"run \"1\"","test_count":3})"sv);
+    }
+
+    SECTION("test case") {
+        framework.test_case.func = []() {};
+        framework.run_test();
+
+        constexpr std::string_view id =
+            R"("id":{"name":"mock_test","tags":"[mock_tag]","type":"mock_type"})";
+
+        snitch::small_string<256> expected;
+        append_or_truncate(expected, R"({"event":"test_case_started",)", id, "}");
+        CHECK(output.line(0) == expected.str());
+
+        const std::string_view ended = output.line(1);
+        CHECK(ended.starts_with(R"({"event":"test_case_ended",)"sv));
+        CHECK(ended.find(id) != ended.npos);
+        CHECK(ended.find(R"("state":"success","assertion_count":0)"sv) != ended.npos);
+    }
+
+    SECTION("failure") {
+        framework.test_case.func = []() {
+            SNITCH_CAPTURE(1);
+            SNITCH_SECTION("section") {
+                SNITCH_FAIL_CHECK("line\nbreak\ttab\x01");
+            }
+        };
+        framework.run_test();
+
+        const std::string_view started = output.line(1);
+        CHECK(started.starts_with(R"({"event":"section_started","id":{)"sv));
+        CHECK(started.ends_with(R"("sections":[{"name":"section","description":""}]})"sv));
+
+        const std::string_view line = output.line(2);
+        CHECK(line.starts_with(R"({"event":"assertion_failed","id":{)"sv));
+        CHECK(line.find(R"("location":{"file":")"sv) != line.npos);
+        CHECK(line.find(R"("sections":[{"name":"section","description":""}])"sv) != line.npos);
+        CHECK(line.find(R"("captures":["1 := 1"])"sv) != line.npos);
+        CHECK(line.find(R"("message":"line\nbreak\ttab\u0001")"sv) != line.npos);
+        CHECK(line.ends_with(R"("expected":false,"allowed":false})"sv));
+
+        const std::string_view ended = output.line(3);
+        CHECK(ended.starts_with(R"({"event":"section_ended","id":{)"sv));
+        CHECK(ended.find(R"("sections":[{"name":"section","description":""}])"sv) != ended.npos);
+    }
+
+    SECTION("skip") {
+        framework.test_case.func = []() { SNITCH_SKIP("later"); };
+        framework.run_test();
+
+        const std::string_view line = output.line(1);
+        CHECK(line.starts_with(R"({"event":"test_case_skipped","id":{)"sv));
+        CHECK(line.ends_with(R"("sections":[],"captures":[],"message":"later"})"sv));
+        CHECK(output.line(2).find(R"("state":"skipped")"sv) != std::string_view::npos);
+    }
+
+    SECTION("passed assertion") {
+        const snitch::assertion_location                  location{"file.cpp", 12u};
+        const snitch::small_vector<snitch::section_id, 1> sections = {};
+        const snitch::small_vector<std::string_view, 1>   captures = {};
+        framework.registry.report_callback(
+            framework.registry, snitch::event::assertion_passed{
+                                    framework.test_case.id, sections.span(), captures.span(),
+                                    location});
+
+        CHECK(
+            output.line(0) ==
+            R"({"event":"assertion_passed","id":{"name":"mock_test","tags":"[mock_tag]",)"
+            R"("type":"mock_type"},"location":{"file":"file.cpp","line":12},"sections":[],)"
+            R"("captures":[]})"sv);
+    }
+}
@@ -0,0 +1,142 @@
+#include "snitch/snitch_junit.hpp"
+#include "testing.hpp"
+#include "testing_event.hpp"
+
+#include <cstdio>
+
+using namespace std::literals;
+
+namespace {
+bool contains(std::string_view string, std::string_view pattern) {
+    return string.find(pattern) != string.npos;
+}
+} // namespace
+
+TEST_CASE("junit reporter", "[junit]") {
+    output_file output;
+    REQUIRE(output.file != nullptr);
+
+    mock_framework          framework;
+    snitch::junit::reporter junit{output.file};
+    framework.registry.report_callback = {
+        junit, snitch::constant<&snitch::junit::reporter::report>{}};
+
+    framework.registry.report_callback(framework.registry, snitch::event::test_run_started{"run"});
+
+    SECTION("passing test") {
+        framework.test_case.func = []() {};
+        framework.run_test();
+        framework.registry.report_callback(
+            framework.registry,
+            snitch::event::test_run_ended{.name = "run", .success = true, .run_count = 1u});
+
+        const std::string_view xml = output.read();
+        CHECK(xml.starts_with("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<testsuites>\n"sv));
+        CHECK(contains(xml, "<testsuite name=\"run\" tests=\"1\" failures=\"0\" skipped=\"0\""sv));
+        CHECK(contains(xml, "<testcase classname=\"run\" name=\"mock_test [mock_type]\""sv));
+        CHECK(contains(xml, "\"/>\n"sv));
+        CHECK(xml.ends_with("  </testsuite>\n</testsuites>\n"sv));
+    }
+
+    SECTION("failing test") {
+        framework.test_case.func = []() {
+            SNITCH_FAIL_CHECK("a < b && \"c\"");
+            SNITCH_FAIL_CHECK("second");
+        };
+        framework.run_test();
+        framework.registry.report_callback(
+            framework.registry,
+            snitch::event::test_run_ended{
+                .name = "run", .success = false, .run_count = 1u, .fail_count = 1u});
+
+        const std::string_view xml = output.read();
+        CHECK(contains(xml, "tests=\"1\" failures=\"1\""sv));
+        CHECK(contains(xml, "<failure message=\"a &lt; b &amp;&amp; &quot;c&quot;\">"sv));
+        CHECK(contains(xml, "<failure message=\"second\">"sv));
+        CHECK(contains(xml, "junit.cpp:"sv));
+        CHECK(contains(xml, "    </testcase>\n"sv));
+    }
+
+    SECTION("escaping") {
+        framework.test_case.func = []() { SNITCH_FAIL_CHECK("tab\tbell\a'quote'"); };
+        framework.run_test();
+
+        // Long enough to be escaped in several chunks.
+        snitch::small_string<1024> name;
+        for (std::size_t i = 0; i < 200; ++i) {
+            append_or_truncate(name, "a&b");
+        }
+
+        framework.registry.report_callback(
+            framework.registry, snitch::event::test_run_ended{.name = name, .run_count = 1u});
+
+        const std::string_view xml = output.read();
+        CHECK(contains(xml, "<failure message=\"tab&#9;bell?&apos;quote&apos;\">"sv));
+
+        constexpr std::string_view prefix = "<testsuite name=\""sv;
+        const std::size_t          start  = xml.find(prefix) + prefix.size();
+        const std::size_t          end    = xml.find('"', start);
+        REQUIRE(end != xml.npos);
+        const std::string_view escaped_name = xml.substr(start, end - start);
+        CHECK(escaped_name.size() == 200u * 7u);
+        CHECK(escaped_name.starts_with("a&amp;ba&amp;b"sv));
+        CHECK(escaped_name.ends_with("a&amp;ba&amp;b"sv));
+        CHECK(escaped_name.find("&b") == escaped_name.npos);
+    }
+
+    SECTION("skipped test") {
+        framework.test_case.func = []() { SNITCH_SKIP("not today"); };
+        framework.run_test();
+        framework.registry.report_callback(
+            framework.registry,
+            snitch::event::test_run_ended{.name = "run", .run_count = 1u, .skip_count = 1u});
+
+        const std::string_view xml = output.read();
+        CHECK(contains(xml, "skipped=\"1\""sv));
+        CHECK(contains(xml, "<skipped message=\"not today\">"sv));
+    }
+
+    SECTION("many test cases") {
+        framework.test_case.func = []() {};
+        for (std::size_t i = 0; i < 10; ++i) {
+            framework.run_test();
+        }
+        framework.registry.report_callback(
+            framework.registry, snitch::event::test_run_ended{.name = "run", .run_count = 10u});
+
+        const std::string_view xml   = output.read();
+        std::size_t            count = 0;
+        for (auto pos = xml.find("<testcase "); pos != xml.npos; pos = xml.find("<testcase ", pos)) {
+            ++count;
+            ++pos;
+        }
+        CHECK(count == 10u);
+    }
+}
+
+TEST_CASE("junit reporter selected", "[junit]") {
+    constexpr const char* path = "snitch_junit_selected.xml";
+
+    mock_framework framework;
+    framework.registry.add_reporter(
+        "junit", &snitch::impl::make_reporter<snitch::junit::reporter>);
+    framework.registry.add({"expression", "[tag]"}, []() {
+        int value = 1;
+        SNITCH_CHECK(value == 2);
+    });
+
+    REQUIRE(framework.registry.select_reporter("junit::out=snitch_junit_selected.xml"));
+    framework.registry.run_all_tests("run");
+    framework.registry.clear_reporters();
+
+    std::FILE* file = std::fopen(path, "r");
+    REQUIRE(file != nullptr);
+    snitch::small_string<4096> contents;
+    contents.resize(std::fread(contents.data(), 1u, contents.capacity(), file));
+    std::fclose(file);
+    std::remove(path);
+
+    const std::string_view xml = contents.str();
+    CHECK(contains(xml, "tests=\"1\" failures=\"1\""sv));
+    CHECK(contains(xml, "<failure message=\"CHECK(value == 2), got 1 != 2\">"sv));
+}
@@ -1,6 +1,11 @@
 #include "testing.hpp"
 
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
 #include <stdexcept>
+#include <vector>
 
 using namespace std::literals;
 
@@ -109,3 +114,312 @@ TEST_CASE("matcher is_any_of", "[utility]") {
         m.describe_match(5u, snitch::matchers::match_status::failed) ==
         "'5' was not found in {'1', '2', '3'}"sv);
 }
+
+namespace {
+enum class opcode : unsigned char { nop = 0, load = 10, store = 20, jump = 30, halt = 255 };
+
+constexpr auto valid_values = snitch::matchers::is_any_of{
+    -1, 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89,
+    97, 101, 1 << 20, -(1 << 30)};
+
+static_assert(
+    std::is_same_v<decltype(valid_values.lookup), snitch::impl::hashed_lookup<int, 29>>);
+static_assert(valid_values.match(97));
+static_assert(valid_values.match(-(1 << 30)));
+static_assert(!valid_values.match(4));
+} // namespace
+
+TEST_CASE("matcher is_any_of large", "[utility]") {
+    SECTION("hashed") {
+        for (int i = -10; i <= 110; ++i) {
+            bool expected = false;
+            for (int v : valid_values.list) {
+                expected = expected || v == i;
+            }
+
+            CAPTURE(i);
+            CHECK(valid_values.match(i) == expected);
+        }
+
+        CHECK((1 << 20) == valid_values);
+        CHECK((1 << 21) != valid_values);
+    }
+
+    SECTION("hashed enum") {
+        const auto m = snitch::matchers::is_any_of{
+            opcode::nop, opcode::load, opcode::store, opcode::jump, opcode::halt, opcode::nop,
+            opcode::load, opcode::store, opcode::jump, opcode::halt, opcode::nop, opcode::load,
+            opcode::store, opcode::jump, opcode::halt, opcode::store, opcode::jump};
+
+        static_assert(
+            std::is_same_v<decltype(m.lookup), snitch::impl::hashed_lookup<opcode, 17>>);
+        CHECK(opcode::halt == m);
+        CHECK(opcode::jump == m);
+        CHECK(opcode{11} != m);
+    }
+
+    SECTION("sorted") {
+        const auto m = snitch::matchers::is_any_of{
+            "nop"sv, "mov"sv, "add"sv, "sub"sv, "mul"sv, "div"sv, "and"sv, "or"sv,   "xor"sv,
+            "not"sv, "shl"sv, "shr"sv, "cmp"sv, "jmp"sv, "jz"sv,  "jnz"sv, "call"sv, "ret"sv};
+
+        static_assert(std::is_same_v<
+                      decltype(m.lookup), snitch::impl::sorted_lookup<std::string_view, 18>>);
+        for (const auto& v : m.list) {
+            CHECK(v == m);
+        }
+
+        CHECK("push"sv != m);
+        CHECK(""sv != m);
+        CHECK("zzz"sv != m);
+    }
+
+    SECTION("describe_match keeps the order") {
+        CHECK(valid_values.describe_match(4, snitch::matchers::match_status::failed)
+                  .str()
+                  .starts_with("'4' was not found in {'-1', '2', '3', '5', '7', '11', "sv));
+    }
+}
+
+TEST_CASE("matcher equals_range", "[utility]") {
+    const std::vector<int> expected = {1, -2, 3, 4, 5, 6, 7, 8, 9};
+    const std::vector<int> same     = expected;
+    const std::vector<int> values   = {1, 2, 3, 4, 5, 0, 7, 8, 0};
+    const std::vector<int> short_   = {1, -2, 3};
+    const auto             m        = snitch::matchers::equals_range(expected);
+
+    CHECK(same == m);
+    CHECK(values != m);
+    CHECK(short_ != m);
+    CHECK(
+        m.describe_match(values, snitch::matchers::match_status::failed) ==
+        "3 of 9 elements differ, at indices 1, 5, 8; max error 9 at index 8 (got 0, expected 9)"sv);
+    CHECK(
+        m.describe_match(same, snitch::matchers::match_status::matched) ==
+        "all 9 elements match"sv);
+    CHECK(
+        m.describe_match(short_, snitch::matchers::match_status::failed) ==
+        "range has 3 elements, expected 9"sv);
+
+    SECTION("many mismatches") {
+        const std::vector<std::uint8_t> large_expected(4096u, 0u);
+        std::vector<std::uint8_t>       large(4096u, 0u);
+
+        const auto m_large = snitch::matchers::equals_range(large_expected);
+        CHECK(large == m_large);
+
+        for (std::size_t i = 100u; i < 200u; ++i) {
+            large[i] = static_cast<std::uint8_t>(i);
+        }
+
+        CHECK(large != m_large);
+        CHECK(
+            m_large.describe_match(large, snitch::matchers::match_status::failed) ==
+            "100 of 4096 elements differ, at indices 100, 101, 102, 103, 104, ...; "
+            "max error 199 at index 199 (got 199, expected 0)"sv);
+    }
+}
+
+TEST_CASE("matcher all_close", "[utility]") {
+    const std::vector<double> expected = {1.0, 100.0, 0.0, -5.0};
+    const std::vector<double> close    = {1.001, 100.1, 0.0, -5.005};
+    const std::vector<double> far      = {1.001, 100.1, 0.1, -5.005};
+
+    CHECK(expected == snitch::matchers::all_close(expected, 1e-6));
+    CHECK(close == snitch::matchers::all_close(expected, 1e-3));
+    CHECK(close != snitch::matchers::all_close(expected, 1e-4));
+    CHECK(far != snitch::matchers::all_close(expected, 1e-3));
+    CHECK(far == snitch::matchers::all_close(expected, 1e-3, 0.2));
+
+    SECTION("special values") {
+        constexpr double inf = std::numeric_limits<double>::infinity();
+        constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+
+        const std::vector<double> special      = {inf, -inf, 1.0};
+        const std::vector<double> wrong_sign   = {inf, inf, 1.0};
+        const std::vector<double> not_a_number = {inf, -inf, nan};
+        const auto                m = snitch::matchers::all_close(special, 1e-6);
+
+        CHECK(special == m);
+        CHECK(wrong_sign != m);
+        CHECK(not_a_number != m);
+        CHECK(m.describe_match(not_a_number, snitch::matchers::match_status::failed)
+                  .str()
+                  .starts_with("1 of 3 elements differ, at indices 2; max error nan at index 2"sv));
+    }
+
+    SECTION("float") {
+        const std::vector<float> expected_float = {1.0f, 2.0f};
+        const std::vector<float> close_float    = {1.0f, 2.0005f};
+        const std::vector<float> far_float      = {1.0f, 2.5f};
+        const auto               m = snitch::matchers::all_close(expected_float, 1e-3f);
+
+        CHECK(close_float == m);
+        CHECK(far_float != m);
+        CHECK(
+            m.describe_match(far_float, snitch::matchers::match_status::failed) ==
+            "1 of 2 elements differ, at indices 1; max error 0.5 at index 1 (got 2.5, expected 2)"sv);
+    }
+}
+
+TEST_CASE("matcher within_ulp", "[utility]") {
+    const float next_one = std::nextafter(1.0f, 2.0f);
+    const float next_two = std::nextafter(next_one, 2.0f);
+    const float min_sub  = std::numeric_limits<float>::denorm_min();
+
+    const std::vector<float> expected  = {1.0f, 0.0f, -1.0f};
+    const std::vector<float> neg_zero  = {1.0f, -0.0f, -1.0f};
+    const std::vector<float> one_ulp   = {next_one, min_sub, -1.0f};
+    const std::vector<float> two_ulp   = {next_two, -min_sub, -1.0f};
+    const std::vector<float> two_ulp_0 = {next_two, 0.0f, -1.0f};
+
+    CHECK(neg_zero == snitch::matchers::within_ulp(expected, 0u));
+    CHECK(one_ulp == snitch::matchers::within_ulp(expected, 1u));
+    CHECK(two_ulp != snitch::matchers::within_ulp(expected, 1u));
+    CHECK(two_ulp == snitch::matchers::within_ulp(expected, 2u));
+
+    const auto m = snitch::matchers::within_ulp(expected, 1u);
+    CHECK(m.describe_match(two_ulp_0, snitch::matchers::match_status::failed)
+              .str()
+              .starts_with("1 of 3 elements differ, at indices 0; max error 2 ulp at index 0"sv));
+
+    SECTION("double") {
+        const std::vector<double> expected_double = {1.0, 1e300};
+        const std::vector<double> below_one       = {std::nextafter(1.0, 0.0), 1e300};
+        const std::vector<double> smaller         = {1.0, 1e299};
+        const std::vector<double> negative        = {1.0, -1e300};
+        const auto                m_double = snitch::matchers::within_ulp(expected_double, 4u);
+
+        CHECK(below_one == m_double);
+        CHECK(smaller != m_double);
+        CHECK(negative != m_double);
+    }
+}
+
+TEST_CASE("matcher range large buffer", "[utility]") {
+    std::vector<float> signal(1u << 16u);
+    for (std::size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = static_cast<float>(i % 256u) / 256.0f;
+    }
+
+    const std::vector<float> copy = signal;
+    CHECK(signal == snitch::matchers::equals_range(copy));
+    CHECK(signal == snitch::matchers::all_close(copy, 1e-6f));
+    CHECK(std::span<const float>(signal) == snitch::matchers::within_ulp(copy, 0u));
+
+    signal.back() = 2.0f;
+    CHECK(signal != snitch::matchers::equals_range(copy));
+}
+
+namespace snitch::matchers {
+struct counting_matcher {
+    bool         result = true;
+    std::size_t* count  = nullptr;
+
+    bool match(std::string_view) const noexcept {
+        ++*count;
+        return result;
+    }
+
+    small_string<max_message_length>
+    describe_match(std::string_view, match_status status) const noexcept {
+        return small_string<max_message_length>(
+            status == match_status::matched ? "matched"sv : "failed"sv);
+    }
+};
+} // namespace snitch::matchers
+
+TEST_CASE("matcher combinators", "[utility]") {
+    using snitch::matchers::contains_substring;
+    using snitch::matchers::match_status;
+
+    const auto hello = contains_substring{"hello"};
+    const auto world = contains_substring{"world"};
+
+    SECTION("and") {
+        const auto m = hello && world;
+        static_assert(snitch::matcher_for<decltype(m), std::string_view>);
+
+        CHECK("hello world"sv == m);
+        CHECK("hello"sv != m);
+        CHECK("world"sv != m);
+        CHECK(
+            m.describe_match("hello you"sv, match_status::failed) ==
+            "could not find 'world' in 'hello you'"sv);
+        CHECK(
+            m.describe_match("hi world"sv, match_status::failed) ==
+            "could not find 'hello' in 'hi world'"sv);
+        CHECK(
+            m.describe_match("hello world"sv, match_status::matched) ==
+            "found 'hello' in 'hello world' and found 'world' in 'hello world'"sv);
+    }
+
+    SECTION("or") {
+        const auto m = hello || world;
+        static_assert(snitch::matcher_for<decltype(m), std::string_view>);
+
+        CHECK("hello"sv == m);
+        CHECK("world"sv == m);
+        CHECK("hi"sv != m);
+        CHECK(
+            m.describe_match("hi"sv, match_status::failed) ==
+            "could not find 'hello' in 'hi' and could not find 'world' in 'hi'"sv);
+        CHECK(
+            m.describe_match("world"sv, match_status::matched) == "found 'world' in 'world'"sv);
+    }
+
+    SECTION("not") {
+        const auto m = !hello;
+        static_assert(snitch::matcher_for<decltype(m), std::string_view>);
+
+        CHECK("hi"sv == m);
+        CHECK("hello"sv != m);
+        CHECK(m.describe_match("hello"sv, match_status::failed) == "found 'hello' in 'hello'"sv);
+        CHECK(
+            m.describe_match("hi"sv, match_status::matched) == "could not find 'hello' in 'hi'"sv);
+    }
+
+    SECTION("nested") {
+        const auto m = (hello || world) && !contains_substring{"bye"};
+        CHECK("hello world"sv == m);
+        CHECK("hello bye"sv != m);
+        CHECK("hi"sv != m);
+        CHECK(
+            m.describe_match("world, bye"sv, match_status::failed) ==
+            "found 'bye' in 'world, bye'"sv);
+    }
+
+    SECTION("short circuit") {
+        std::size_t count = 0u;
+
+        const auto pass = snitch::matchers::counting_matcher{true, &count};
+        const auto fail = snitch::matchers::counting_matcher{false, &count};
+
+        CHECK(!(fail && pass).match("a"sv));
+        CHECK(count == 1u);
+        CHECK((pass || fail).match("a"sv));
+        CHECK(count == 2u);
+        CHECK((pass && fail).describe_match("a"sv, match_status::failed) == "failed"sv);
+    }
+
+    SECTION("other types") {
+        const auto m = snitch::matchers::is_any_of{1, 2, 3} || snitch::matchers::is_any_of{10, 20};
+        CHECK(2 == m);
+        CHECK(20 == m);
+        CHECK(5 != m);
+    }
+    SECTION("not a matcher") {
+        static_assert(snitch::matchers::matcher<contains_substring>);
+        static_assert(!snitch::matchers::matcher<std::optional<match_status>>);
+        static_assert(!snitch::matchers::matcher<match_status>);
+
+        // Classes found by argument-dependent lookup keep the built-in operators.
+        const std::optional<match_status> none;
+        const std::optional<match_status> some = match_status::matched;
+        static_assert(std::is_same_v<decltype(!none), bool>);
+        static_assert(std::is_same_v<decltype(none && some), bool>);
+        CHECK(!none);
+        CHECK((none || some));
+        CHECK(!(none && some));
+    }
+}
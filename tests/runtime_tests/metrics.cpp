@@ -0,0 +1,112 @@
+#include "snitch/snitch_async.hpp"
+#include "snitch/snitch_metrics.hpp"
+#include "testing.hpp"
+#include "testing_event.hpp"
+
+#include <cstdio>
+
+using namespace std::literals;
+
+namespace {
+snitch::event::test_case_ended
+make_ended(const snitch::test_id& id, snitch::test_case_state state, [[maybe_unused]] float d) {
+    snitch::event::test_case_ended e{id, state, 2u};
+#if SNITCH_WITH_TIMINGS
+    e.duration = d;
+#endif
+    return e;
+}
+} // namespace
+
+TEST_CASE("metrics reporter", "[metrics]") {
+    output_file output;
+    REQUIRE(output.file != nullptr);
+
+    mock_framework            framework;
+    snitch::metrics::reporter metrics{output.file, 0.5f};
+
+    const snitch::test_id fast{"fast", "[a][b]", ""};
+    const snitch::test_id slow{"slow \"1\"", "[b]", "int"};
+    const snitch::test_id skipped{"skipped", "", ""};
+
+    metrics.report(framework.registry, snitch::event::test_run_started{"run"});
+    metrics.report(framework.registry, make_ended(fast, snitch::test_case_state::success, 0.002f));
+    metrics.report(framework.registry, make_ended(slow, snitch::test_case_state::failed, 2.0f));
+    metrics.report(framework.registry, make_ended(skipped, snitch::test_case_state::skipped, 0.0f));
+
+    snitch::event::test_run_ended ended{"run", false, 3u, 1u, 1u, 6u};
+    metrics.report(framework.registry, ended);
+
+    SECTION("counts") {
+        CHECK(output.has_line("# TYPE snitch_test_cases gauge"sv));
+        CHECK(output.has_line(R"(snitch_test_cases{state="success"} 1)"sv));
+        CHECK(output.has_line(R"(snitch_test_cases{state="failed"} 1)"sv));
+        CHECK(output.has_line(R"(snitch_test_cases{state="skipped"} 1)"sv));
+        CHECK(output.has_line("snitch_assertions 6"sv));
+        CHECK(output.has_line("snitch_success 0"sv));
+        CHECK(output.read().ends_with("\n# EOF\n"sv));
+    }
+
+#if SNITCH_WITH_TIMINGS
+    SECTION("durations") {
+        CHECK(output.has_line("# TYPE snitch_test_case_duration_seconds histogram"sv));
+        CHECK(output.has_line(R"(snitch_test_case_duration_seconds_bucket{le="0.001"} 1)"sv));
+        CHECK(output.has_line(R"(snitch_test_case_duration_seconds_bucket{le="0.01"} 2)"sv));
+        CHECK(output.has_line(R"(snitch_test_case_duration_seconds_bucket{le="1"} 2)"sv));
+        CHECK(output.has_line(R"(snitch_test_case_duration_seconds_bucket{le="10"} 3)"sv));
+        CHECK(output.has_line(R"(snitch_test_case_duration_seconds_bucket{le="+Inf"} 3)"sv));
+        CHECK(output.has_line("snitch_test_case_duration_seconds_count 3"sv));
+    }
+
+    SECTION("tag durations") {
+        CHECK(output.has_line(R"(snitch_tag_duration_seconds_bucket{tag="a",le="0.01"} 1)"sv));
+        CHECK(output.has_line(R"(snitch_tag_duration_seconds_bucket{tag="b",le="0.01"} 1)"sv));
+        CHECK(output.has_line(R"(snitch_tag_duration_seconds_bucket{tag="b",le="10"} 2)"sv));
+        CHECK(output.has_line(R"(snitch_tag_duration_seconds_count{tag="a"} 1)"sv));
+        CHECK(output.has_line(R"(snitch_tag_duration_seconds_count{tag="b"} 2)"sv));
+        CHECK(output.read().find(R"(tag="")"sv) == std::string_view::npos);
+    }
+
+    SECTION("slow tests") {
+        CHECK(output.has_line(
+            R"(snitch_slow_test_case_duration_seconds{name="slow \"1\" [int]"} 2)"sv));
+        CHECK(output.read().find(R"(name="fast")"sv) == std::string_view::npos);
+    }
+#endif
+}
+
+#if SNITCH_WITH_TIMINGS
+TEST_CASE("metrics reporter behind async reporter", "[metrics]") {
+    output_file output;
+    REQUIRE(output.file != nullptr);
+
+    // All test cases are slow, so they are all listed by name.
+    mock_framework             framework;
+    snitch::metrics::reporter  metrics{output.file, 0.0f};
+    snitch::async::reporter<4> async{
+        {metrics, snitch::constant<&snitch::metrics::reporter::report>{}}};
+    framework.registry.report_callback = {
+        async, snitch::constant<&snitch::async::reporter<4>::report>{}};
+
+    // The strings of the events are overwritten as the ring of the async reporter wraps around.
+    framework.registry.add({"t1", "[alpha]"}, []() {});
+    framework.registry.add({"t2", "[beta]"}, []() {});
+    framework.registry.add({"t3", "[gamma]"}, []() {});
+    framework.registry.add({"t4", "[delta]"}, []() {});
+    framework.registry.add({"t5", "[epsilon]"}, []() {});
+    framework.registry.run_all_tests("run");
+
+    for (std::string_view tag : {"alpha"sv, "beta"sv, "gamma"sv, "delta"sv, "epsilon"sv}) {
+        snitch::small_string<128> line;
+        append_or_truncate(line, "snitch_tag_duration_seconds_count{tag=\"", tag, "\"} 1");
+        CHECK(output.has_line(line));
+    }
+
+    for (std::string_view name : {"t1"sv, "t2"sv, "t3"sv, "t4"sv, "t5"sv}) {
+        snitch::small_string<128> sample;
+        append_or_truncate(
+            sample, "\nsnitch_slow_test_case_duration_seconds{name=\"", name, "\"} ");
+        CHECK(output.read().find(sample) != std::string_view::npos);
+    }
+}
+#endif
@@ -0,0 +1,69 @@
+#include "snitch/snitch_progress.hpp"
+#include "testing.hpp"
+#include "testing_event.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+using namespace std::literals;
+
+TEST_CASE("progress line", "[progress]") {
+    snitch::progress::sample s{.total = 121, .done = 37, .assertions = 13701};
+    s.elapsed = 3.0f;
+
+    SECTION("with estimate") {
+        s.eta = 12.4f;
+        CHECK(
+            snitch::progress::make_line(s) ==
+            "[ 37/121] 12.3 tests/s, 4567 assertions/s, ETA 0:12"sv);
+    }
+
+    SECTION("without estimate") {
+        CHECK(snitch::progress::make_line(s).str().ends_with("ETA ?"sv));
+    }
+
+    SECTION("durations") {
+        snitch::small_string<32> string;
+        CHECK(snitch::progress::append_duration(string, 65.0f));
+        CHECK(string == "1:05"sv);
+
+        string.clear();
+        CHECK(snitch::progress::append_duration(string, 3725.0f));
+        CHECK(string == "1:02:05"sv);
+    }
+}
+
+TEST_CASE("progress reporter", "[progress]") {
+    constexpr const char* path = "snitch_progress_status.json";
+
+    output_file output;
+    REQUIRE(output.file != nullptr);
+
+    mock_framework framework;
+    framework.registry.add({"pass", "[tag]"}, []() {});
+    framework.registry.add({"fail", "[tag]"}, []() { SNITCH_FAIL_CHECK("no"); });
+    framework.registry.add({"skip", "[other]"}, []() { SNITCH_SKIP("later"); });
+    framework.registry.print_callback = [](std::string_view) noexcept {};
+
+    {
+        // The interval is long enough for the line to only be written at the end of the run.
+        snitch::progress::reporter progress{output.file, path, std::chrono::hours{1}};
+        framework.registry.report_callback = {
+            progress, snitch::constant<&snitch::progress::reporter::report>{}};
+
+        framework.registry.run_tests_matching_name("test_app", "a");
+    }
+
+    const std::string_view line = output.read();
+    CHECK(line.starts_with("\r[2/2] "sv));
+    CHECK(line.ends_with(" ETA 0:00\n"sv));
+
+    output_file status_file{std::fopen(path, "r")};
+    REQUIRE(status_file.file != nullptr);
+    const std::string_view status = status_file.read();
+    std::remove(path);
+
+    CHECK(status.starts_with(
+        R"({"name":"test_app","running":false,"total":2,"done":2,"failed":1,"skipped":0,)"
+        R"("assertions":1,)"sv));
+}
@@ -1,7 +1,18 @@
 #include "testing.hpp"
 #include "testing_event.hpp"
 
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iterator>
 #include <stdexcept>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#    include <sys/wait.h>
+#    include <unistd.h>
+#endif
 
 using namespace std::literals;
 using snitch::matchers::contains_substring;
@@ -15,10 +26,28 @@ bool        test_called_float     = false;
 bool        test_called_hidden1   = false;
 bool        test_called_hidden2   = false;
 std::size_t failure_line          = 0u;
+std::size_t test_run_count        = 0u;
 
 enum class reporter { print, custom };
+
+struct event_counter {
+    std::FILE*  output = nullptr;
+    std::size_t count  = 0u;
+
+    explicit event_counter(std::FILE* out) noexcept : output(out) {}
+
+    void report(const snitch::registry&, const snitch::event::data&) noexcept {
+        ++count;
+    }
+};
 } // namespace
 
+// A copy would share the list of test cases of the original.
+static_assert(!std::is_copy_constructible_v<snitch::registry>);
+static_assert(!std::is_move_constructible_v<snitch::registry>);
+static_assert(!std::is_copy_assignable_v<snitch::registry>);
+static_assert(!std::is_move_assignable_v<snitch::registry>);
+
 TEST_CASE("add regular test", "[registry]") {
     mock_framework framework;
 
@@ -91,6 +120,48 @@ TEST_CASE("add regular test no tags", "[registry]") {
     }
 }
 
+TEST_CASE("add test stored by the caller", "[registry]") {
+    // SNITCH_MAX_TEST_CASES only limits the test cases stored in the registry.
+    constexpr std::size_t                                     count = snitch::max_test_cases + 10u;
+    std::array<snitch::impl::test_case, count>                tests;
+    snitch::impl::typed_test_cases<int, float>                typed_tests;
+    snitch::impl::type_list_test_cases<snitch::type_list<int>> listed_tests;
+
+    mock_framework framework;
+    for (auto& test : tests) {
+        test = {{"how many lights", "[tag]"}, []() { ++test_run_count; }};
+        CHECK(framework.registry.add(test) == "how many lights"sv);
+    }
+
+    framework.registry.add_with_types<int, float>(
+        typed_tests, "how many templated lights", "[tag]", []<typename T>() { ++test_run_count; });
+    framework.registry.add_with_type_list<snitch::type_list<int>>(
+        listed_tests, "how many listed lights", "[tag]", []<typename T>() { ++test_run_count; });
+
+    REQUIRE(framework.get_num_registered_tests() == count + 3u);
+
+    auto iter = framework.registry.begin();
+    for (const auto& test : tests) {
+        CHECK(&*iter++ == &test);
+    }
+
+    CHECK(&*iter++ == &typed_tests[0]);
+    CHECK(&*iter++ == &typed_tests[1]);
+    CHECK(&*iter++ == &listed_tests[0]);
+    CHECK(iter == framework.registry.end());
+
+    CHECK(typed_tests[0].id.name == "how many templated lights"sv);
+    CHECK(typed_tests[0].id.type == "int"sv);
+    CHECK(typed_tests[1].id.type == "float"sv);
+    CHECK(listed_tests[0].id.name == "how many listed lights"sv);
+    CHECK(listed_tests[0].id.type == "int"sv);
+
+    test_run_count                    = 0u;
+    framework.registry.print_callback = [](std::string_view) noexcept {};
+    CHECK(framework.registry.run_all_tests("test_app"));
+    CHECK(test_run_count == count + 3u);
+}
+
 TEST_CASE("add template test", "[registry]") {
     for (bool with_type_list : {false, true}) {
         mock_framework framework;
@@ -133,7 +204,7 @@ TEST_CASE("add template test", "[registry]") {
         CHECK(test1.id.type == "int"sv);
         REQUIRE(test1.func != nullptr);
 
-        auto& test2 = *(framework.registry.begin() + 1);
+        auto& test2 = *std::next(framework.registry.begin());
         CHECK(test2.id.name == "how many lights"sv);
         CHECK(test2.id.tags == "[tag]"sv);
         CHECK(test2.id.type == "float"sv);
@@ -427,6 +498,55 @@ TEST_CASE("report SKIP", "[registry]") {
     }
 }
 
+TEST_CASE("report failures with limit per site", "[registry]") {
+    mock_framework framework;
+
+    framework.registry.add({"how many lights", "[tag]"}, []() {
+        for (std::size_t i = 0; i < 10u; ++i) {
+            // clang-format off
+            failure_line = __LINE__; SNITCH_CHECK(i == 4u);
+            // clang-format on
+        }
+
+        SNITCH_FAIL_CHECK("there are four lights");
+    });
+
+    auto& test = *framework.registry.begin();
+
+    SECTION("no limit") {
+        framework.setup_reporter();
+        framework.registry.run(test);
+
+        CHECK(framework.get_num_failures() == 10u);
+        CHECK(framework.get_num_suppressed() == 0u);
+    }
+
+    SECTION("default reporter") {
+        framework.setup_print();
+        framework.registry.max_failures_per_site = 2u;
+        framework.registry.run(test);
+
+        CHECK(framework.messages == contains_substring("there are four lights"));
+        CHECK(framework.messages == contains_substring("... and 7 more failures at "));
+    }
+
+    SECTION("custom reporter") {
+        framework.setup_reporter();
+        framework.registry.max_failures_per_site = 2u;
+        framework.registry.run(test);
+
+        CHECK(framework.get_num_failures() == 3u);
+        REQUIRE(framework.get_num_suppressed() == 1u);
+        auto suppressed_opt = framework.get_suppressed_event(0u);
+        REQUIRE(suppressed_opt.has_value());
+        const auto& suppressed = suppressed_opt.value();
+        CHECK_EVENT_TEST_ID(suppressed, test.id);
+        CHECK_EVENT_LOCATION(suppressed, __FILE__, failure_line);
+        CHECK(suppressed.suppressed_count == 7u);
+        CHECK_CASE(snitch::test_case_state::failed, 11u);
+    }
+}
+
 SNITCH_WARNING_POP
 
 namespace {
@@ -490,6 +610,256 @@ void register_tests(mock_framework& framework) {
 }
 } // namespace
 
+#if defined(__unix__) || defined(__APPLE__)
+namespace {
+// Sends the standard output of the process, and the stream given to reporters writing to it, to
+// a temporary file, to check what was written to them.
+struct stdout_redirect {
+    std::FILE* file         = std::tmpfile();
+    int        saved        = -1;
+    int        saved_stream = -1;
+
+    stdout_redirect() {
+        if (file == nullptr) {
+            return;
+        }
+
+        snitch::impl::stdout_flush();
+        saved        = ::dup(STDOUT_FILENO);
+        saved_stream = ::dup(::fileno(snitch::impl::stdout_file()));
+        ::dup2(::fileno(file), STDOUT_FILENO);
+        ::dup2(::fileno(file), ::fileno(snitch::impl::stdout_file()));
+    }
+
+    ~stdout_redirect() {
+        restore();
+        if (file != nullptr) {
+            std::fclose(file);
+        }
+    }
+
+    void restore() {
+        if (saved < 0) {
+            return;
+        }
+
+        snitch::impl::stdout_flush();
+        ::dup2(saved, STDOUT_FILENO);
+        ::dup2(saved_stream, ::fileno(snitch::impl::stdout_file()));
+        ::close(saved);
+        ::close(saved_stream);
+        saved        = -1;
+        saved_stream = -1;
+    }
+
+    // Returns what was written to the file so far, without flushing anything.
+    snitch::small_string<4096> read() const {
+        snitch::small_string<4096> contents;
+        const auto size = ::pread(::fileno(file), contents.data(), contents.capacity(), 0);
+        contents.resize(size > 0 ? static_cast<std::size_t>(size) : 0u);
+        return contents;
+    }
+};
+
+// Reporter writing the failures and the captured output of test cases to its file.
+struct output_printer {
+    std::FILE* output = nullptr;
+
+    explicit output_printer(std::FILE* out) noexcept : output(out) {}
+
+    void write(std::string_view prefix, std::string_view message) noexcept {
+        std::fwrite(prefix.data(), 1u, prefix.size(), output);
+        std::fwrite(message.data(), 1u, message.size(), output);
+        std::fputc('\n', output);
+    }
+
+    void report(const snitch::registry&, const snitch::event::data& e) noexcept {
+        if (const auto* failure = std::get_if<snitch::event::assertion_failed>(&e)) {
+            write("failure: ", failure->message);
+        } else if (const auto* ended = std::get_if<snitch::event::test_case_ended>(&e)) {
+            write("output: ", ended->output);
+        }
+    }
+};
+} // namespace
+
+TEST_CASE("output order", "[registry]") {
+    mock_framework framework;
+    framework.setup_print();
+    framework.registry.print_callback = &snitch::impl::stdout_print;
+    framework.registry.add({"printing", "[tag]"}, []() { std::printf("from test;"); });
+
+    auto& test = *framework.registry.begin();
+
+    SECTION("flush") {
+        stdout_redirect redirect;
+        REQUIRE(redirect.file != nullptr);
+
+        snitch::impl::stdout_print("buffered;");
+        std::printf("stdio;");
+        const auto before = redirect.read();
+        snitch::impl::stdout_flush();
+        const auto after = redirect.read();
+        redirect.restore();
+
+        CHECK(before.empty());
+        CHECK(after == "stdio;buffered;"sv);
+    }
+
+    SECTION("test end") {
+        stdout_redirect redirect;
+        REQUIRE(redirect.file != nullptr);
+
+        framework.registry.run(test);
+        const auto output = redirect.read();
+        redirect.restore();
+
+        const auto started  = output.str().find("starting: printing");
+        const auto printed  = output.str().find("from test;");
+        const auto finished = output.str().find("finished: printing");
+        REQUIRE(finished != std::string_view::npos);
+        CHECK(started < printed);
+        CHECK(printed < finished);
+    }
+
+    SECTION("failure") {
+        framework.registry.add({"failing", "[tag]"}, []() {
+            SNITCH_FAIL_CHECK("trigger");
+            std::printf("after failure;");
+        });
+
+        stdout_redirect redirect;
+        REQUIRE(redirect.file != nullptr);
+
+        framework.registry.run(*std::next(framework.registry.begin()));
+        const auto output = redirect.read();
+        redirect.restore();
+
+        // Failures are not flushed as they are reported, but at the end of the test case.
+        const auto printed  = output.str().find("after failure;");
+        const auto failed   = output.str().find("trigger");
+        const auto finished = output.str().find("finished: failing");
+        REQUIRE(finished != std::string_view::npos);
+        CHECK(printed < failed);
+        CHECK(failed < finished);
+    }
+
+    SECTION("capture start") {
+        framework.registry.capture_output = true;
+
+        stdout_redirect redirect;
+        REQUIRE(redirect.file != nullptr);
+
+        std::printf("stdio;");
+        snitch::impl::stdout_print("buffered;");
+        framework.registry.run(test);
+        const auto output = redirect.read();
+        redirect.restore();
+
+        CHECK(output.str().starts_with("stdio;buffered;"sv));
+        CHECK(output.str().find("finished: printing") != std::string_view::npos);
+        CHECK(output.str().find("from test;") == std::string_view::npos);
+    }
+
+    SECTION("terminate") {
+        stdout_redirect redirect;
+        REQUIRE(redirect.file != nullptr);
+
+        const pid_t pid = ::fork();
+        if (pid == 0) {
+            std::set_terminate([]() { std::_Exit(3); });
+            std::printf("stdio;");
+            snitch::impl::stdout_print("buffered;");
+            snitch::terminate_with("stop");
+        }
+
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        const auto output = redirect.read();
+        redirect.restore();
+
+        REQUIRE(pid > 0);
+        CHECK(WIFEXITED(status));
+        CHECK(WEXITSTATUS(status) == 3);
+        CHECK(output == "stdio;buffered;terminate called with message: stop\n"sv);
+    }
+}
+
+TEST_CASE("capture output", "[registry]") {
+    mock_framework framework;
+    framework.registry.capture_output = true;
+
+    framework.registry.add({"quiet", "[tag]"}, []() {
+        std::printf("not shown\n");
+        std::fputs("not shown either\n", stderr);
+    });
+
+    framework.registry.add({"noisy", "[tag]"}, []() {
+        std::printf("out\n");
+        std::fflush(stdout);
+        std::fputs("err", stderr);
+        SNITCH_FAIL_CHECK("there are four lights");
+    });
+
+    auto& quiet = *framework.registry.begin();
+    auto& noisy = *std::next(framework.registry.begin());
+
+    SECTION("passed") {
+        framework.setup_reporter();
+        framework.registry.run(quiet);
+
+        REQUIRE(framework.events.size() == 2u);
+        CHECK(framework.events[1].event_type == event_deep_copy::type::test_case_ended);
+        CHECK(framework.events[1].message.empty());
+    }
+
+    SECTION("failed") {
+        framework.setup_reporter();
+        framework.registry.run(noisy);
+
+        REQUIRE(framework.events.size() == 3u);
+        CHECK(framework.events[2].event_type == event_deep_copy::type::test_case_ended);
+        CHECK(framework.events[2].message == "out\nerr"sv);
+    }
+
+    SECTION("default reporter") {
+        framework.setup_print();
+        framework.registry.run(quiet);
+        framework.registry.run(noisy);
+
+        CHECK(framework.messages == contains_substring("there are four lights"));
+        CHECK(
+            framework.messages ==
+            contains_substring("captured from test case \"noisy\"\nout\nerr\n"));
+        CHECK(framework.messages != contains_substring("not shown"));
+    }
+}
+
+TEST_CASE("capture output with a reporter on stdout", "[registry]") {
+    mock_framework framework;
+    framework.registry.capture_output = true;
+    framework.registry.add_reporter("printer", &snitch::impl::make_reporter<output_printer>);
+    framework.registry.add({"noisy", "[tag]"}, []() {
+        std::printf("out\n");
+        SNITCH_FAIL_CHECK("there are four lights");
+        std::printf("more out\n");
+    });
+
+    stdout_redirect redirect;
+    REQUIRE(redirect.file != nullptr);
+
+    const bool selected = framework.registry.select_reporter("printer");
+    framework.registry.run(*framework.registry.begin());
+    framework.registry.clear_reporters();
+    const auto output = redirect.read();
+    redirect.restore();
+
+    // The events reported while the test case runs are not part of its captured output.
+    CHECK(selected);
+    CHECK(output == "failure: there are four lights\noutput: out\nmore out\n\n"sv);
+}
+#endif
+
 TEST_CASE("run tests", "[registry]") {
     mock_framework framework;
     register_tests(framework);
@@ -801,6 +1171,33 @@ TEST_CASE("configure", "[registry]") {
         CHECK(framework.registry.verbose == snitch::registry::verbosity::high);
     }
 
+    SECTION("max failures = 10") {
+        const arg_vector args = {"test", "--max-failures", "10"};
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+
+        CHECK(framework.registry.max_failures_per_site == 10u);
+    }
+
+    SECTION("capture output") {
+        const arg_vector args = {"test", "--capture-output"};
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+
+        CHECK(framework.registry.capture_output);
+    }
+
+    SECTION("max failures = bad") {
+        const arg_vector args = {"test", "--max-failures", "ten"};
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        framework.registry.configure(*input);
+
+        CHECK(framework.registry.max_failures_per_site == 0u);
+        CHECK(
+            framework.messages ==
+            contains_substring("warning:invalid maximum number of failures"));
+    }
+
     SECTION("verbosity = bad") {
         const arg_vector args = {"test", "--verbosity", "bad"};
         auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
@@ -887,3 +1284,135 @@ TEST_CASE("run tests cli", "[registry]") {
         CHECK_RUN(true, 1u, 0u, 1u, 0u);
     }
 }
+
+TEST_CASE("select reporters", "[registry]") {
+    mock_framework framework;
+    framework.setup_reporter_and_print();
+    register_tests(framework);
+
+    framework.registry.add_reporter("counter", &snitch::impl::make_reporter<event_counter>);
+    const auto& counter = snitch::impl::reporter_instance<event_counter>;
+
+    SECTION("several reporters") {
+        CHECK(framework.registry.select_reporter("console"));
+        CHECK(framework.registry.select_reporter("counter"));
+        framework.registry.run_all_tests("test_app");
+
+        CHECK(framework.events.empty());
+        CHECK(framework.messages == contains_substring("some tests failed"));
+        REQUIRE(counter.has_value());
+        CHECK(counter->output == snitch::impl::stdout_file());
+        CHECK(counter->count > 0u);
+    }
+
+    SECTION("output file") {
+        constexpr const char* path = "snitch_select_reporters.txt";
+        CHECK(framework.registry.select_reporter("console::out=snitch_select_reporters.txt"));
+        framework.registry.run_all_tests("test_app");
+        framework.registry.clear_reporters();
+
+        CHECK(framework.events.empty());
+        CHECK(framework.messages.empty());
+
+        std::FILE* file = std::fopen(path, "r");
+        REQUIRE(file != nullptr);
+        snitch::small_string<4096> contents;
+        contents.resize(std::fread(contents.data(), 1u, contents.capacity(), file));
+        std::fclose(file);
+        std::remove(path);
+
+        CHECK(contents == contains_substring("some tests failed"));
+        CHECK(contents == contains_substring("how many lights"));
+    }
+
+    SECTION("expression failure in output file") {
+        framework.registry.add({"expression", "[expression]"}, []() {
+            int four = 4;
+            SNITCH_CHECK(four == 5);
+        });
+
+        constexpr const char* path = "snitch_select_reporters_expr.txt";
+        CHECK(framework.registry.select_reporter("console::out=snitch_select_reporters_expr.txt"));
+        framework.registry.run_tests_with_tag("test_app", "[expression]");
+        framework.registry.clear_reporters();
+
+        CHECK(framework.events.empty());
+        CHECK(framework.messages.empty());
+
+        std::FILE* file = std::fopen(path, "r");
+        REQUIRE(file != nullptr);
+        snitch::small_string<4096> contents;
+        contents.resize(std::fread(contents.data(), 1u, contents.capacity(), file));
+        std::fclose(file);
+        std::remove(path);
+
+        CHECK(contents == contains_substring("CHECK(four == 5), got 4 != 5"));
+    }
+
+    SECTION("from command line") {
+        const arg_vector args = {"test", "--reporter", "counter", "--reporter", "console"};
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        CHECK(framework.registry.configure(*input));
+        framework.registry.run_tests(*input);
+
+        CHECK(framework.events.empty());
+        CHECK(framework.messages == contains_substring("some tests failed"));
+        REQUIRE(counter.has_value());
+        CHECK(counter->count > 0u);
+    }
+
+    SECTION("cleared") {
+        CHECK(framework.registry.select_reporter("console"));
+        framework.registry.clear_reporters();
+        framework.registry.run_all_tests("test_app");
+
+        CHECK_RUN(false, 5u, 3u, 1u, 3u);
+    }
+
+    SECTION("unknown reporter") {
+        CHECK(!framework.registry.select_reporter("carrier_pigeon"));
+        CHECK(framework.messages == contains_substring("unknown reporter 'carrier_pigeon'"));
+    }
+
+    SECTION("selected twice") {
+        CHECK(framework.registry.select_reporter("counter"));
+        CHECK(!framework.registry.select_reporter("counter::out=other.txt"));
+        CHECK(framework.messages == contains_substring("reporter 'counter' is already selected"));
+    }
+
+    SECTION("specification changed after selection") {
+        snitch::small_string<32> specification = "counter"sv;
+        CHECK(framework.registry.select_reporter(specification));
+        specification = "console"sv;
+
+        CHECK(!framework.registry.select_reporter("counter"));
+        CHECK(framework.registry.select_reporter("console"));
+    }
+
+    SECTION("unknown option") {
+        CHECK(!framework.registry.select_reporter("console::in=file.txt"));
+        CHECK(
+            framework.messages ==
+            contains_substring("unknown option 'in=file.txt' for reporter 'console'"));
+    }
+
+    SECTION("bad output file") {
+        CHECK(!framework.registry.select_reporter("console::out=missing/folder/file.txt"));
+        CHECK(
+            framework.messages ==
+            contains_substring("could not open 'missing/folder/file.txt' for reporter 'console'"));
+    }
+
+    SECTION("unknown reporter from command line") {
+        const arg_vector args = {"test", "--reporter", "counter", "--reporter", "carrier_pigeon"};
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        CHECK(!framework.registry.configure(*input));
+        CHECK(framework.messages == contains_substring("unknown reporter 'carrier_pigeon'"));
+    }
+
+    SECTION("bad output file from command line") {
+        const arg_vector args = {"test", "--reporter", "console::out=missing/folder/file.txt"};
+        auto input = snitch::cli::parse_arguments(static_cast<int>(args.size()), args.data());
+        CHECK(!framework.registry.configure(*input));
+    }
+}
@@ -217,6 +217,40 @@ TEST_CASE("section", "[test macros]") {
         CHECK_SECTIONS_FOR_FAILURE(4u, "section 2");
         CHECK_CASE(snitch::test_case_state::failed, 60u);
     }
+
+    SECTION("section events") {
+        framework.test_case.func = []() {
+            SNITCH_SECTION("section 1") {
+                SNITCH_SECTION("section 1.1") {
+                    SNITCH_FAIL_CHECK("trigger");
+                }
+                SNITCH_SECTION("section 1.2") {
+                    SNITCH_FAIL("abort");
+                }
+            }
+        };
+
+        framework.run_test();
+
+        // Sections left by an exception are also reported as ended.
+        using type            = event_deep_copy::type;
+        const type expected[] = {
+            type::test_case_started, type::section_started, type::section_started,
+            type::assertion_failed,  type::section_ended,   type::section_ended,
+            type::section_started,   type::section_started, type::assertion_failed,
+            type::section_ended,     type::section_ended,   type::test_case_ended};
+
+        REQUIRE(framework.events.size() == std::size(expected));
+        for (std::size_t i = 0; i < std::size(expected); ++i) {
+            CHECK(framework.events[i].event_type == expected[i]);
+        }
+
+        REQUIRE(framework.events[2].sections.size() == 2u);
+        CHECK(framework.events[2].sections[0] == "section 1"sv);
+        CHECK(framework.events[2].sections[1] == "section 1.1"sv);
+        REQUIRE(framework.events[8].sections.size() == 2u);
+        CHECK(framework.events[8].sections[1] == "section 1.2"sv);
+    }
 }
 
 SNITCH_WARNING_POP
@@ -265,3 +299,47 @@ TEST_CASE("section readme example", "[test macros]") {
 
     CHECK(events == "S|1|E|S|2|E|S|3|3.1|E|S|3|3.2|E"sv);
 }
+
+TEST_CASE("section nesting depth", "[test macros]") {
+    mock_framework framework;
+
+    std::size_t section_count = 0u;
+    std::string last_section;
+
+    framework.registry.report_callback = [&](const snitch::registry&,
+                                             const snitch::event::data& e) noexcept {
+        if (const auto* f = std::get_if<snitch::event::assertion_failed>(&e)) {
+            section_count = f->sections.size();
+            last_section.assign(f->sections.empty() ? ""sv : f->sections.back().name);
+        }
+    };
+
+    // Deeper than the sections kept in a copy of an event.
+    framework.test_case.func = []() {
+        SNITCH_SECTION("1") {
+            SNITCH_SECTION("2") {
+                SNITCH_SECTION("3") {
+                    SNITCH_SECTION("4") {
+                        SNITCH_SECTION("5") {
+                            SNITCH_SECTION("6") {
+                                SNITCH_SECTION("7") {
+                                    SNITCH_SECTION("8") {
+                                        SNITCH_SECTION("9") {
+                                            SNITCH_SECTION("10") {
+                                                SNITCH_FAIL_CHECK("trigger");
+                                            }
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    framework.run_test();
+    CHECK(section_count == 10u);
+    CHECK(last_section == "10");
+}
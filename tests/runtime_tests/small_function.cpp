@@ -169,5 +169,50 @@ TEMPLATE_TEST_CASE(
             }
             CHECK(test_object_instances <= expected_instances);
         }
+
+        SECTION("from temporary stateful lambda") {
+            int answer = 47;
+            f          = snitch::small_function<TestType>{[answer](Args...) noexcept -> R {
+                function_called = true;
+                if constexpr (!std::is_same_v<R, void>) {
+                    return answer;
+                }
+            }};
+            answer     = 0;
+            CHECK(!f.empty());
+
+            call_function(f);
+
+            CHECK(function_called);
+            if (!std::is_same_v<R, void>) {
+                CHECK(return_value == 47);
+            }
+            CHECK(test_object_instances <= expected_instances);
+        }
+
+        SECTION("from mutable lambda") {
+            auto lambda = [count = 48](Args...) mutable noexcept -> R {
+                function_called = true;
+                if constexpr (!std::is_same_v<R, void>) {
+                    return count++;
+                }
+            };
+
+            // Temporaries are called as const, so mutable lambdas must be given by reference.
+            static_assert(
+                !std::is_constructible_v<snitch::small_function<TestType>, decltype(lambda)>);
+
+            f = snitch::small_function<TestType>{lambda};
+            CHECK(!f.empty());
+
+            call_function(f);
+            call_function(f);
+
+            CHECK(function_called);
+            if (!std::is_same_v<R, void>) {
+                CHECK(return_value == 49);
+            }
+            CHECK(test_object_instances <= 2 * expected_instances);
+        }
     }(type_holder<TestType>{});
 }
@@ -409,3 +409,54 @@ TEST_CASE("constexpr small string", "[utility]") {
         CHECK(v[2] == 'c');
     }
 }
+
+TEST_CASE("small string bulk operations", "[utility]") {
+    SECTION("assign") {
+        string_type v = "abc"sv;
+        v.assign("de"sv);
+        CHECK(v.str() == "de"sv);
+
+        v.assign("fghij");
+        CHECK(v.str() == "fghij"sv);
+    }
+
+    SECTION("append_range") {
+        string_type v = "ab"sv;
+        v.append_range("cd");
+        CHECK(v.str() == "abcd"sv);
+    }
+
+    SECTION("insert") {
+        string_type v = "ae"sv;
+        CHECK(v.insert(1u, "bcd") == v.begin() + 1u);
+        CHECK(v.str() == "abcde"sv);
+    }
+
+    SECTION("erase") {
+        string_type v = "abcde"sv;
+        v.erase(1u, 3u);
+        CHECK(v.str() == "ae"sv);
+        v.erase(1u);
+        CHECK(v.str() == "a"sv);
+    }
+
+    SECTION("through span") {
+        string_type v = "ac"sv;
+        span_type   s = v;
+        s.insert(1u, "b");
+        s.append_range(""sv);
+        CHECK(v.str() == "abc"sv);
+    }
+
+    SECTION("constexpr") {
+        constexpr string_type v = []() {
+            string_type v = "ae"sv;
+            v.insert(1u, "bcd");
+            v.erase(0u, 2u);
+            v.append_range("f");
+            return v;
+        }();
+
+        CHECK(v.str() == "cdef"sv);
+    }
+}
@@ -169,6 +169,75 @@ TEMPLATE_TEST_CASE("small vector", "[utility]", vector_type, span_type, const_sp
                 CHECK(v.back().b == true);
             }
 
+            SECTION("assign") {
+                const test_struct elems[] = {{1, false}, {2, true}, {3, false}};
+                v.assign(elems);
+
+                CHECK(v.size() == 3u);
+                CHECK(v.available() == max_test_elements - 3u);
+                CHECK(v[0].i == 1);
+                CHECK(v[1].i == 2);
+                CHECK(v[2].i == 3);
+                CHECK(v[2].b == false);
+            }
+
+            SECTION("append_range") {
+                const test_struct elems[] = {{1, false}, {2, true}};
+                v.append_range(elems);
+
+                CHECK(v.size() == 4u);
+                CHECK(v.available() == max_test_elements - 4u);
+                CHECK(v[0].i == 4);
+                CHECK(v[1].i == 6);
+                CHECK(v[2].i == 1);
+                CHECK(v[3].i == 2);
+                CHECK(v[3].b == true);
+            }
+
+            SECTION("append_range empty") {
+                v.append_range({});
+
+                CHECK(v.size() == 2u);
+                CHECK(v.back().i == 6);
+            }
+
+            SECTION("insert") {
+                const test_struct elems[] = {{1, false}, {2, true}};
+                test_struct*      first   = v.insert(1u, elems);
+
+                CHECK(first == v.begin() + 1u);
+                CHECK(v.size() == 4u);
+                CHECK(v[0].i == 4);
+                CHECK(v[1].i == 1);
+                CHECK(v[2].i == 2);
+                CHECK(v[3].i == 6);
+                CHECK(v[3].b == false);
+            }
+
+            SECTION("insert at end") {
+                const test_struct elems[] = {{1, false}};
+                v.insert(2u, elems);
+
+                CHECK(v.size() == 3u);
+                CHECK(v[1].i == 6);
+                CHECK(v[2].i == 1);
+            }
+
+            SECTION("erase") {
+                v.erase(0u);
+
+                CHECK(v.size() == 1u);
+                CHECK(v[0].i == 6);
+                CHECK(v[0].b == false);
+            }
+
+            SECTION("erase all") {
+                v.erase(0u, 2u);
+
+                CHECK(v.empty());
+                CHECK(v.available() == max_test_elements);
+            }
+
             SECTION("clear") {
                 v.clear();
 
@@ -486,3 +555,53 @@ TEST_CASE("constexpr small vector int", "[utility]") {
         CHECK(v[2] == 5);
     }
 }
+
+TEST_CASE("small vector bulk operations", "[utility]") {
+    using TestType = snitch::small_vector<int, max_test_elements>;
+
+    SECTION("ranges") {
+        static_assert(std::ranges::contiguous_range<TestType>);
+        static_assert(std::ranges::sized_range<TestType>);
+        static_assert(std::ranges::contiguous_range<snitch::small_vector_span<int>>);
+        static_assert(std::ranges::borrowed_range<snitch::small_vector_span<int>>);
+        static_assert(std::ranges::borrowed_range<snitch::small_vector_span<const int>>);
+
+        TestType       v     = {1, 2, 3};
+        std::span<int> whole = v;
+        CHECK(whole.size() == 3u);
+        CHECK(whole.data() == v.data());
+    }
+
+    SECTION("from another vector") {
+        const TestType source = {1, 2, 3};
+
+        TestType v = {4, 5};
+        v.insert(1u, source);
+        CHECK(v.size() == max_test_elements);
+        CHECK(v[0] == 4);
+        CHECK(v[1] == 1);
+        CHECK(v[2] == 2);
+        CHECK(v[3] == 3);
+        CHECK(v[4] == 5);
+    }
+
+    SECTION("constexpr") {
+        constexpr TestType v = []() {
+            const int elems[] = {1, 2, 3, 4};
+
+            TestType v;
+            v.assign(elems);
+            v.erase(1u, 2u);
+            v.insert(1u, std::span(elems).first(2u));
+            v.append_range(std::span(elems).last(1u));
+            return v;
+        }();
+
+        CHECK(v.size() == max_test_elements);
+        CHECK(v[0] == 1);
+        CHECK(v[1] == 1);
+        CHECK(v[2] == 2);
+        CHECK(v[3] == 4);
+        CHECK(v[4] == 4);
+    }
+}
@@ -0,0 +1,77 @@
+#include "snitch/snitch_teamcity.hpp"
+#include "testing.hpp"
+#include "testing_event.hpp"
+
+using namespace std::literals;
+
+namespace {
+struct print_counter {
+    snitch::small_string<4086> messages;
+    std::size_t                count = 0;
+
+    void print(std::string_view message) noexcept {
+        append_or_truncate(messages, message);
+        ++count;
+    }
+};
+} // namespace
+
+TEST_CASE("teamcity escape", "[teamcity]") {
+    SECTION("nothing to escape") {
+        snitch::small_string<32> s = "hello world"sv;
+        snitch::teamcity::escape(s);
+        CHECK(s == "hello world"sv);
+    }
+
+    SECTION("all special characters") {
+        snitch::small_string<32> s = "a|b'c\nd\re[f]g"sv;
+        snitch::teamcity::escape(s);
+        CHECK(s == "a||b|'c|nd|re|[f|]g"sv);
+    }
+
+    SECTION("only special characters") {
+        snitch::small_string<32> s = "[[]]"sv;
+        snitch::teamcity::escape(s);
+        CHECK(s == "|[|[|]|]"sv);
+    }
+
+    SECTION("overflow") {
+        snitch::small_string<10> s = "[a][b][c]"sv;
+        snitch::teamcity::escape(s);
+        CHECK(s == "|[a|]|[..."sv);
+    }
+
+    SECTION("append escaped") {
+        snitch::small_string<32> s = "x="sv;
+        CHECK(snitch::teamcity::append_escaped(s, "f<int[2]>"sv));
+        CHECK(s == "x=f<int|[2|]>"sv);
+
+        snitch::small_string<4> t;
+        CHECK(!snitch::teamcity::append_escaped(t, "ab[c"sv));
+        CHECK(t == "ab|["sv);
+    }
+}
+
+TEST_CASE("teamcity reporter", "[teamcity]") {
+    mock_framework framework;
+    print_counter  counter;
+
+    framework.registry.print_callback  = {counter, snitch::constant<&print_counter::print>{}};
+    framework.registry.report_callback = &snitch::teamcity::report;
+
+    SECTION("one print per message") {
+        framework.test_case.func = []() { SNITCH_FAIL_CHECK("vector<int[3]>'s size"); };
+        framework.run_test();
+
+        CHECK(counter.count == 3u);
+        CHECK(counter.messages.str().starts_with(
+            "##teamCity[testStarted name='mock_test(\"mock_type\")']\n"
+            "##teamCity[testFailed name='mock_test(\"mock_type\")' message='"sv));
+        CHECK(counter.messages.str().find("  vector<int|[3|]>|'s size']\n"sv) != std::string_view::npos);
+    }
+
+    SECTION("run events") {
+        snitch::teamcity::report(framework.registry, snitch::event::test_run_started{"[run]"});
+        CHECK(counter.messages == "##teamCity[testSuiteStarted name='|[run|]']\n"sv);
+    }
+}
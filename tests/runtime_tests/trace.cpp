@@ -0,0 +1,64 @@
+#include "snitch/snitch_trace.hpp"
+#include "testing.hpp"
+#include "testing_event.hpp"
+
+#include <cstdio>
+
+using namespace std::literals;
+using snitch::matchers::contains_substring;
+
+TEST_CASE("trace reporter", "[trace]") {
+    output_file output;
+    REQUIRE(output.file != nullptr);
+
+    mock_framework          framework;
+    snitch::trace::reporter trace{output.file};
+    framework.registry.report_callback = {
+        trace, snitch::constant<&snitch::trace::reporter::report>{}};
+
+    SECTION("test run") {
+        framework.registry.report_callback(
+            framework.registry, snitch::event::test_run_started{"run \"1\""});
+        framework.registry.report_callback(
+            framework.registry, snitch::event::test_run_ended{.name = "run \"1\""});
+
+        CHECK(output.line(0) == "["sv);
+        CHECK(output.line(1).starts_with(
+            R"({"name":"thread_name","cat":"__metadata","ph":"M","ts":0.000,"pid":1,"tid":1,)"sv));
+        CHECK(output.line(1).ends_with(R"("args":{"name":"thread 1"}},)"sv));
+        CHECK(output.line(2).starts_with(
+            R"({"name":"run \"1\"","cat":"run","ph":"B","ts":0.000,"pid":1,"tid":1})"sv));
+        CHECK(output.line(3).starts_with(R"({"name":"run \"1\"","cat":"run","ph":"E","ts":)"sv));
+        CHECK(output.line(3).ends_with(R"("fail_count":0,"skip_count":0,"assertion_count":0}})"sv));
+        CHECK(output.line(4) == "]"sv);
+    }
+
+    SECTION("spans and instants") {
+        framework.test_case.func = []() {
+            SNITCH_CAPTURE(1);
+            SNITCH_SECTION("section") {
+                SNITCH_FAIL_CHECK("oops");
+            }
+            SNITCH_SKIP("later");
+        };
+        framework.run_test();
+
+        CHECK(output.line(0) == "["sv);
+        CHECK(output.line(2).starts_with(
+            R"({"name":"mock_test [mock_type]","cat":"test_case","ph":"B","ts":)"sv));
+        CHECK(output.line(2).ends_with(R"("args":{"tags":"[mock_tag]","type":"mock_type"}},)"sv));
+        CHECK(output.line(3).starts_with(R"({"name":"section","cat":"section","ph":"B","ts":)"sv));
+
+        const std::string_view failure = output.line(4);
+        CHECK(failure.starts_with(R"({"name":"failure","cat":"assertion","ph":"i","ts":)"sv));
+        CHECK(failure == contains_substring(R"("tid":1,"s":"t","args":{"file":")"));
+        CHECK(failure.ends_with(
+            R"("message":"oops","section":"section","capture 1":"1 := 1"}},)"sv));
+
+        CHECK(output.line(5).starts_with(R"({"name":"section","cat":"section","ph":"E","ts":)"sv));
+        CHECK(output.line(6).starts_with(R"({"name":"skipped","cat":"test_case","ph":"i","ts":)"sv));
+        CHECK(output.line(7).starts_with(
+            R"({"name":"mock_test [mock_type]","cat":"test_case","ph":"E","ts":)"sv));
+        CHECK(output.line(7).ends_with(R"("args":{"state":"failed","assertion_count":1}})"sv));
+    }
+}
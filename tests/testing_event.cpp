@@ -4,6 +4,8 @@
 // clang-format on
 
 #include <algorithm>
+#include <cstdio>
+#include <iterator>
 
 namespace {
 template<typename T>
@@ -75,6 +77,17 @@ event_deep_copy deep_copy(const snitch::event::data& e) {
                 copy_full_location(c, a);
                 return c;
             },
+            [](const snitch::event::assertion_passed& a) {
+                event_deep_copy c;
+                c.event_type = event_deep_copy::type::assertion_passed;
+                copy_test_case_id(c, a);
+                append_or_truncate(c.location_file, a.location.file);
+                c.location_line = a.location.line;
+                for (const auto& es : a.sections) {
+                    c.sections.push_back(es.name);
+                }
+                return c;
+            },
             [](const snitch::event::test_case_started& s) {
                 event_deep_copy c;
                 c.event_type = event_deep_copy::type::test_case_started;
@@ -87,6 +100,25 @@ event_deep_copy deep_copy(const snitch::event::data& e) {
                 copy_test_case_id(c, s);
                 c.test_case_state           = s.state;
                 c.test_case_assertion_count = s.assertion_count;
+                append_or_truncate(c.message, s.output);
+                return c;
+            },
+            [](const snitch::event::section_started& s) {
+                event_deep_copy c;
+                c.event_type = event_deep_copy::type::section_started;
+                copy_test_case_id(c, s);
+                for (const auto& es : s.sections) {
+                    c.sections.push_back(es.name);
+                }
+                return c;
+            },
+            [](const snitch::event::section_ended& s) {
+                event_deep_copy c;
+                c.event_type = event_deep_copy::type::section_ended;
+                copy_test_case_id(c, s);
+                for (const auto& es : s.sections) {
+                    c.sections.push_back(es.name);
+                }
                 return c;
             },
             [](const snitch::event::test_run_started& s) {
@@ -106,6 +138,15 @@ event_deep_copy deep_copy(const snitch::event::data& e) {
                 c.test_run_assertion_count = s.assertion_count;
                 return c;
             },
+            [](const snitch::event::assertion_failures_suppressed& s) {
+                event_deep_copy c;
+                c.event_type = event_deep_copy::type::assertion_failures_suppressed;
+                copy_test_case_id(c, s);
+                append_or_truncate(c.location_file, s.location.file);
+                c.location_line    = s.location.line;
+                c.suppressed_count = s.count;
+                return c;
+            },
             [](const snitch::event::test_case_skipped& s) {
                 event_deep_copy c;
                 c.event_type = event_deep_copy::type::test_case_skipped;
@@ -117,6 +158,10 @@ event_deep_copy deep_copy(const snitch::event::data& e) {
 }
 
 void mock_framework::report(const snitch::registry&, const snitch::event::data& e) noexcept {
+    if (!record_passed && std::holds_alternative<snitch::event::assertion_passed>(e)) {
+        return;
+    }
+
     events.push_back(deep_copy(e));
 }
 
@@ -159,8 +204,16 @@ std::optional<event_deep_copy> mock_framework::get_skip_event() const {
     return get_event(events, event_deep_copy::type::test_case_skipped, 0u);
 }
 
+std::optional<event_deep_copy> mock_framework::get_suppressed_event(std::size_t id) const {
+    return get_event(events, event_deep_copy::type::assertion_failures_suppressed, id);
+}
+
+std::optional<event_deep_copy> mock_framework::get_passed_event(std::size_t id) const {
+    return get_event(events, event_deep_copy::type::assertion_passed, id);
+}
+
 std::size_t mock_framework::get_num_registered_tests() const {
-    return registry.end() - registry.begin();
+    return static_cast<std::size_t>(std::distance(registry.begin(), registry.end()));
 }
 
 std::size_t mock_framework::get_num_runs() const {
@@ -174,3 +227,52 @@ std::size_t mock_framework::get_num_failures() const {
 std::size_t mock_framework::get_num_skips() const {
     return count_events(events, event_deep_copy::type::test_case_skipped);
 }
+
+std::size_t mock_framework::get_num_suppressed() const {
+    return count_events(events, event_deep_copy::type::assertion_failures_suppressed);
+}
+
+std::size_t mock_framework::get_num_passed() const {
+    return count_events(events, event_deep_copy::type::assertion_passed);
+}
+
+output_file::~output_file() {
+    if (file != nullptr) {
+        std::fclose(file);
+    }
+}
+
+std::string_view output_file::read() {
+    std::fflush(file);
+    std::rewind(file);
+    contents.resize(std::fread(contents.data(), 1u, contents.capacity(), file));
+    std::fseek(file, 0, SEEK_END);
+    return contents.str();
+}
+
+std::string_view output_file::line(std::size_t index) {
+    std::string_view lines = read();
+    for (std::size_t i = 0; i < index && !lines.empty(); ++i) {
+        lines.remove_prefix(std::min(lines.find('\n'), lines.size() - 1u) + 1u);
+    }
+
+    return lines.substr(0, lines.find('\n'));
+}
+
+bool output_file::has_line(std::string_view line) {
+    const std::string_view text = read();
+    for (std::size_t pos = text.find(line); pos != text.npos; pos = text.find(line, pos + 1u)) {
+        const bool starts = pos == 0u || text[pos - 1u] == '\n';
+        const bool ends   = pos + line.size() == text.size() || text[pos + line.size()] == '\n';
+        if (starts && ends) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+long output_file::size() {
+    std::fseek(file, 0, SEEK_END);
+    return std::ftell(file);
+}
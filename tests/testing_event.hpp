@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <cstdio>
 #include <vector>
 
 struct event_deep_copy {
@@ -9,7 +10,11 @@ struct event_deep_copy {
         test_case_started,
         test_case_ended,
         test_case_skipped,
-        assertion_failed
+        section_started,
+        section_ended,
+        assertion_failed,
+        assertion_passed,
+        assertion_failures_suppressed
     };
 
     type event_type = type::unknown;
@@ -31,6 +36,8 @@ struct event_deep_copy {
     snitch::small_string<snitch::max_message_length> location_file;
     std::size_t                                      location_line = 0u;
 
+    std::size_t suppressed_count = 0u;
+
     snitch::small_string<snitch::max_message_length> message;
     snitch::small_vector<snitch::small_string<snitch::max_message_length>, snitch::max_captures>
         captures;
@@ -49,8 +56,10 @@ struct mock_framework {
         .func  = nullptr,
         .state = snitch::impl::test_case_state::not_run};
 
-    snitch::small_vector<event_deep_copy, 16> events;
+    snitch::small_vector<event_deep_copy, 32> events;
     snitch::small_string<4086>                messages;
+    // Passed assertions are only recorded on request, so they do not crowd out other events.
+    bool record_passed = false;
 
     void report(const snitch::registry&, const snitch::event::data& e) noexcept;
     void print(std::string_view msg) noexcept;
@@ -65,10 +74,36 @@ struct mock_framework {
 
     std::optional<event_deep_copy> get_skip_event() const;
 
+    std::optional<event_deep_copy> get_suppressed_event(std::size_t id = 0) const;
+
+    std::optional<event_deep_copy> get_passed_event(std::size_t id = 0) const;
+
     std::size_t get_num_registered_tests() const;
     std::size_t get_num_runs() const;
     std::size_t get_num_failures() const;
     std::size_t get_num_skips() const;
+    std::size_t get_num_suppressed() const;
+    std::size_t get_num_passed() const;
+};
+
+// Owns a file, by default a temporary one, and reads back what was written to it.
+struct output_file {
+    std::FILE*                 file = std::tmpfile();
+    snitch::small_string<8192> contents;
+
+    output_file() = default;
+    explicit output_file(std::FILE* f) : file(f) {}
+
+    output_file(const output_file&)            = delete;
+    output_file& operator=(const output_file&) = delete;
+
+    ~output_file();
+
+    // Reads the whole file; writing can resume after the call.
+    std::string_view read();
+    std::string_view line(std::size_t index);
+    bool             has_line(std::string_view line);
+    long             size();
 };
 
 struct console_output_catcher {
@@ -0,0 +1,224 @@
+#include <cstdio> // for std::fopen
+#include <map> // for merged sites
+#include <optional> // for std::optional
+#include <string> // for file names
+#include <string_view> // for arguments
+#include <utility> // for std::pair
+#include <vector> // for file tables
+
+// Merges assertion coverage files, written by snitch::write_assertion_coverage() (for example,
+// by each shard of a test suite), and lists the assertion sites which were never executed.
+//
+// Usage: snitch_coverage <file>... [--output <merged file>]
+
+namespace {
+using namespace std::literals;
+
+using site_key = std::pair<std::string, std::size_t>;
+using site_map = std::map<site_key, bool>;
+
+constexpr std::string_view coverage_header = "SNCV\x01";
+
+std::optional<std::size_t> read_varint(std::FILE* file) noexcept {
+    std::size_t value = 0u;
+    for (std::size_t shift = 0u; shift < 64u; shift += 7u) {
+        const int byte = std::fgetc(file);
+        if (byte == EOF) {
+            return {};
+        }
+
+        value |= static_cast<std::size_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+
+    return {};
+}
+
+void write_varint(std::FILE* file, std::size_t value) noexcept {
+    do {
+        const unsigned char byte = static_cast<unsigned char>(value & 0x7fu);
+        value >>= 7u;
+        std::fputc(value != 0u ? byte | 0x80u : byte, file);
+    } while (value != 0u);
+}
+
+bool read_coverage(std::FILE* file, site_map& sites) {
+    char header[coverage_header.size()];
+    if (std::fread(header, 1u, sizeof(header), file) != sizeof(header) ||
+        std::string_view{header, sizeof(header)} != coverage_header) {
+        return false;
+    }
+
+    const auto file_count = read_varint(file);
+    if (!file_count) {
+        return false;
+    }
+
+    std::vector<std::string> files;
+    for (std::size_t i = 0; i < *file_count; ++i) {
+        const auto length = read_varint(file);
+        if (!length) {
+            return false;
+        }
+
+        std::string name(*length, '\0');
+        if (std::fread(name.data(), 1u, name.size(), file) != name.size()) {
+            return false;
+        }
+
+        files.push_back(std::move(name));
+    }
+
+    const auto site_count = read_varint(file);
+    if (!site_count) {
+        return false;
+    }
+
+    std::vector<site_key> keys;
+    for (std::size_t i = 0; i < *site_count; ++i) {
+        const auto file_index = read_varint(file);
+        const auto line       = read_varint(file);
+        if (!file_index || !line || *file_index >= files.size()) {
+            return false;
+        }
+
+        keys.emplace_back(files[*file_index], *line);
+    }
+
+    for (std::size_t i = 0; i < keys.size(); i += 8u) {
+        const int byte = std::fgetc(file);
+        if (byte == EOF) {
+            return false;
+        }
+
+        for (std::size_t j = i; j < keys.size() && j < i + 8u; ++j) {
+            // Two sites on the same line are merged; the line is executed if either is.
+            bool& executed = sites[keys[j]];
+            executed       = executed || (byte & (1 << (j - i))) != 0;
+        }
+    }
+
+    return true;
+}
+
+void write_coverage(std::FILE* file, const site_map& sites) {
+    std::fwrite(coverage_header.data(), 1u, coverage_header.size(), file);
+
+    // Sites are sorted by file, so each file name is listed once, and in order.
+    std::vector<std::string_view> files;
+    for (const auto& [key, executed] : sites) {
+        if (files.empty() || files.back() != key.first) {
+            files.push_back(key.first);
+        }
+    }
+
+    write_varint(file, files.size());
+    for (const auto& name : files) {
+        write_varint(file, name.size());
+        std::fwrite(name.data(), 1u, name.size(), file);
+    }
+
+    write_varint(file, sites.size());
+    std::size_t file_index = 0u;
+    for (const auto& [key, executed] : sites) {
+        while (files[file_index] != key.first) {
+            ++file_index;
+        }
+
+        write_varint(file, file_index);
+        write_varint(file, key.second);
+    }
+
+    unsigned char byte  = 0u;
+    std::size_t   index = 0u;
+    for (const auto& [key, executed] : sites) {
+        if (executed) {
+            byte |= static_cast<unsigned char>(1u << (index % 8u));
+        }
+
+        ++index;
+        if (index % 8u == 0u) {
+            std::fputc(byte, file);
+            byte = 0u;
+        }
+    }
+
+    if (index % 8u != 0u) {
+        std::fputc(byte, file);
+    }
+}
+
+void print_usage(std::string_view executable) noexcept {
+    std::printf(
+        "usage: %.*s <file>... [--output <merged file>]\n", static_cast<int>(executable.size()),
+        executable.data());
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::string_view executable = argc > 0 ? argv[0] : "snitch_coverage";
+
+    site_map    sites;
+    const char* output_path = nullptr;
+    std::size_t input_count = 0u;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--output"sv) {
+            if (i + 1 == argc) {
+                print_usage(executable);
+                return 1;
+            }
+
+            output_path = argv[++i];
+            continue;
+        }
+
+        std::FILE* file = std::fopen(argv[i], "rb");
+        if (file == nullptr) {
+            std::printf("error: could not open %s\n", argv[i]);
+            return 1;
+        }
+
+        const bool success = read_coverage(file, sites);
+        std::fclose(file);
+
+        if (!success) {
+            std::printf("error: invalid or truncated coverage file %s\n", argv[i]);
+            return 1;
+        }
+
+        ++input_count;
+    }
+
+    if (input_count == 0u) {
+        print_usage(executable);
+        return 1;
+    }
+
+    std::size_t executed_count = 0u;
+    for (const auto& [key, executed] : sites) {
+        if (executed) {
+            ++executed_count;
+        } else {
+            std::printf("never executed: %s:%zu\n", key.first.c_str(), key.second);
+        }
+    }
+
+    std::printf("%zu of %zu assertion sites executed\n", executed_count, sites.size());
+
+    if (output_path != nullptr) {
+        std::FILE* output = std::fopen(output_path, "wb");
+        if (output == nullptr) {
+            std::printf("error: could not open %s\n", output_path);
+            return 1;
+        }
+
+        write_coverage(output, sites);
+        std::fclose(output);
+    }
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include "snitch/snitch.hpp"
+#include "snitch/snitch_binary.hpp"
+#include "snitch/snitch_json.hpp"
+#include "snitch/snitch_junit.hpp"
+#include "snitch/snitch_metrics.hpp"
+#include "snitch/snitch_teamcity.hpp"
+#include "snitch/snitch_trace.hpp"
+
+#include <cstdio> // for std::fopen
+
+// Replays a binary event stream, written by snitch::binary::writer, into one or more of the
+// built-in reporters. Reporters are selected as with the `--reporter` option of a test
+// application, including the "::out=<file>" option; the console reporter is used by default.
+//
+// Usage: snitch_replay <file|-> [--reporter <name>[::out=<file>]]... [--color always|never]
+//                               [--verbosity quiet|normal|high]
+
+namespace {
+using namespace std::literals;
+
+void print_usage(const snitch::registry& r, std::string_view executable) noexcept {
+    r.print(
+        "usage: "sv, executable,
+        " <file|-> [--reporter <name>[::out=<file>]]... [--color always|never] "
+        "[--verbosity quiet|normal|high]\n"sv);
+}
+
+snitch::binary::reader* open_reader(std::FILE* file) noexcept {
+    // The reader is large; keep it out of the stack.
+    static snitch::binary::reader reader{file};
+    return &reader;
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    snitch::registry& r = snitch::tests;
+
+    const std::string_view executable = argc > 0 ? argv[0] : "snitch_replay";
+    if (argc < 2) {
+        print_usage(r, executable);
+        return 1;
+    }
+
+    // The reporters are selected once the other options are known, since they may print errors.
+    snitch::small_vector<std::string_view, snitch::max_reporters> reporters;
+    for (int i = 2; i < argc; ++i) {
+        const std::string_view option = argv[i];
+        if (i + 1 == argc) {
+            print_usage(r, executable);
+            return 1;
+        }
+
+        const std::string_view value = argv[++i];
+        if (option == "--reporter"sv && reporters.available() != 0u) {
+            reporters.push_back(value);
+        } else if (option == "--color"sv && (value == "always"sv || value == "never"sv)) {
+            r.with_color = value == "always"sv;
+        } else if (option == "--verbosity"sv && value == "quiet"sv) {
+            r.verbose = snitch::registry::verbosity::quiet;
+        } else if (option == "--verbosity"sv && value == "normal"sv) {
+            r.verbose = snitch::registry::verbosity::normal;
+        } else if (option == "--verbosity"sv && value == "high"sv) {
+            r.verbose = snitch::registry::verbosity::high;
+        } else {
+            print_usage(r, executable);
+            return 1;
+        }
+    }
+
+    for (const std::string_view reporter : reporters) {
+        if (!r.select_reporter(reporter)) {
+            r.clear_reporters();
+            snitch::impl::stdout_flush();
+            return 1;
+        }
+    }
+
+    const std::string_view path = argv[1];
+    std::FILE*             file = path == "-"sv ? stdin : std::fopen(argv[1], "rb");
+    if (file == nullptr) {
+        r.print("error: could not open "sv, path, "\n"sv);
+        r.clear_reporters();
+        snitch::impl::stdout_flush();
+        return 1;
+    }
+
+    // Events go to the selected reporters, or to the console reporter if none is selected.
+    const bool success = open_reader(file)->replay(
+        r, [](const snitch::registry& reg, const snitch::event::data& event) noexcept {
+            reg.report_event(event);
+        });
+    r.clear_reporters();
+    snitch::impl::stdout_flush();
+
+    if (file != stdin) {
+        std::fclose(file);
+    }
+
+    if (!success) {
+        r.print("error: invalid or truncated event stream\n"sv);
+        snitch::impl::stdout_flush();
+        return 1;
+    }
+
+    return 0;
+}